@@ -82,6 +82,7 @@ int main(int argc, char **argv)
         DEBUG("Cleaning User Data.... (%s<>%s)\n",appver,VERSION);
         path = g_build_filename(g_get_user_config_dir(), "hardinfo2","blobs-update-version.json", NULL);g_remove(path);g_free(path);
         path = g_build_filename(g_get_user_config_dir(), "hardinfo2","benchmark.json", NULL);g_remove(path);g_free(path);
+        path = g_build_filename(g_get_user_config_dir(), "hardinfo2","benchmark.idx", NULL);g_remove(path);g_free(path);
         path = g_build_filename(g_get_user_config_dir(), "hardinfo2","cpuflags.json", NULL);g_remove(path);g_free(path);
         path = g_build_filename(g_get_user_config_dir(), "hardinfo2","kernel-module-icons.json", NULL);g_remove(path);g_free(path);
         path = g_build_filename(g_get_user_config_dir(), "hardinfo2","arm.ids", NULL);g_remove(path);g_free(path);
@@ -156,7 +157,10 @@ int main(int argc, char **argv)
     if (params.run_benchmark) {
         gchar *result;
 
-        result = module_call_method_param("benchmark::runBenchmark", params.run_benchmark);
+        if (params.bench_batch)
+            result = module_call_method_param("benchmark::runBenchmarkBatch", params.run_benchmark);
+        else
+            result = module_call_method_param("benchmark::runBenchmark", params.run_benchmark);
         if (!result) {
           fprintf(stderr, _("Unknown benchmark ``%s''\n"), params.run_benchmark);
           exit_code = 1;
@@ -344,6 +344,21 @@ void parameters_init(int *argc, char ***argv, ProgramParameters * param)
     static gchar *result_format = NULL;
     static gchar *bench_user_note = NULL;
     static gint max_bench_results = 250;
+    static gint bench_repeat = 1;
+    static gint bench_warmup = 1;
+    static gboolean bench_batch = FALSE;
+    static gint bench_gap = 0;
+    static gboolean bench_sweep = FALSE;
+    static gboolean bench_classes = FALSE;
+    static gboolean bench_counters = FALSE;
+    static gchar *bench_storage = NULL;
+    static gboolean bench_zerocopy = FALSE;
+    static gint bench_nqueens_depth = 0;
+    static gdouble bench_precision = 0;
+    static gint bench_budget = 0;
+    static gchar *bench_isolate = NULL;
+    static gint bench_max_load = 0;
+    static gchar *bench_hugepages = NULL;
 
     static GOptionEntry options[] = {
 	{
@@ -400,6 +415,81 @@ void parameters_init(int *argc, char ***argv, ProgramParameters * param)
 	 .arg = G_OPTION_ARG_INT,
 	 .arg_data = &max_bench_results,
 	 .description = N_("maximum number of benchmark results to include (-1 for no limit, default is 250)")},
+	{
+	 .long_name = "bench-repeat",
+	 .arg = G_OPTION_ARG_INT,
+	 .arg_data = &bench_repeat,
+	 .description = N_("run each benchmark N times and record median and spread (default is 1)")},
+	{
+	 .long_name = "bench-warmup",
+	 .arg = G_OPTION_ARG_INT,
+	 .arg_data = &bench_warmup,
+	 .description = N_("untimed warm-up runs before repeated benchmark runs (default is 1)")},
+	{
+	 .long_name = "bench-batch",
+	 .arg = G_OPTION_ARG_NONE,
+	 .arg_data = &bench_batch,
+	 .description = N_("run a comma separated list of benchmarks given with -b (or all) in one process")},
+	{
+	 .long_name = "bench-gap",
+	 .arg = G_OPTION_ARG_INT,
+	 .arg_data = &bench_gap,
+	 .description = N_("idle seconds between benchmarks of a batch to start each one cool (default is 0)")},
+	{
+	 .long_name = "bench-sweep",
+	 .arg = G_OPTION_ARG_NONE,
+	 .arg_data = &bench_sweep,
+	 .description = N_("run multi-thread benchmarks at 1, 2, 4 ... threads and report speedup and efficiency")},
+	{
+	 .long_name = "bench-classes",
+	 .arg = G_OPTION_ARG_NONE,
+	 .arg_data = &bench_classes,
+	 .description = N_("on hybrid cpus also run each benchmark pinned to each core class (P/E cores, big.LITTLE)")},
+	{
+	 .long_name = "bench-counters",
+	 .arg = G_OPTION_ARG_NONE,
+	 .arg_data = &bench_counters,
+	 .description = N_("read hardware performance counters during benchmarks (IPC, cache and branch misses)")},
+	{
+	 .long_name = "bench-storage",
+	 .arg = G_OPTION_ARG_FILENAME,
+	 .arg_data = &bench_storage,
+	 .description = N_("directory, file or block device for the storage benchmark (default is home, devices and files are only read)")},
+	{
+	 .long_name = "bench-zerocopy",
+	 .arg = G_OPTION_ARG_NONE,
+	 .arg_data = &bench_zerocopy,
+	 .description = N_("also send with MSG_ZEROCOPY, sendfile and splice in the internal network benchmark")},
+	{
+	 .long_name = "bench-nqueens-depth",
+	 .arg = G_OPTION_ARG_INT,
+	 .arg_data = &bench_nqueens_depth,
+	 .description = N_("rows placed before the N-Queens search is split into tasks (default 0 is automatic)")},
+	{
+	 .long_name = "bench-precision",
+	 .arg = G_OPTION_ARG_DOUBLE,
+	 .arg_data = &bench_precision,
+	 .description = N_("run timed benchmarks until the 95% CI of their rate is within PCT percent (default 0 is fixed length)")},
+	{
+	 .long_name = "bench-budget",
+	 .arg = G_OPTION_ARG_INT,
+	 .arg_data = &bench_budget,
+	 .description = N_("total seconds the benchmarks of a run may take with --bench-precision (default 0 is no limit)")},
+	{
+	 .long_name = "bench-isolate",
+	 .arg = G_OPTION_ARG_STRING,
+	 .arg_data = &bench_isolate,
+	 .description = N_("run benchmarks only on the cpus of a list like 2-7 (or all), check and record background load")},
+	{
+	 .long_name = "bench-max-load",
+	 .arg = G_OPTION_ARG_INT,
+	 .arg_data = &bench_max_load,
+	 .description = N_("with --bench-isolate, refuse to run when the cpus are more than PCT percent busy (default 0 only warns)")},
+	{
+	 .long_name = "bench-hugepages",
+	 .arg = G_OPTION_ARG_STRING,
+	 .arg_data = &bench_hugepages,
+	 .description = N_("back the per-worker benchmark input with thp or explicit huge pages (default off)")},
 	{
 	 .long_name = "version",
 	 .short_name = 'v',
@@ -455,6 +545,21 @@ void parameters_init(int *argc, char ***argv, ProgramParameters * param)
     param->run_benchmark = run_benchmark;
     param->result_format = result_format;
     param->max_bench_results = max_bench_results;
+    param->bench_repeat = bench_repeat;
+    param->bench_warmup = bench_warmup;
+    param->bench_batch = bench_batch;
+    param->bench_gap = bench_gap;
+    param->bench_sweep = bench_sweep;
+    param->bench_classes = bench_classes;
+    param->bench_counters = bench_counters;
+    param->bench_storage = bench_storage;
+    param->bench_zerocopy = bench_zerocopy;
+    param->bench_nqueens_depth = bench_nqueens_depth;
+    param->bench_precision = bench_precision;
+    param->bench_budget = bench_budget;
+    param->bench_isolate = bench_isolate;
+    param->bench_max_load = bench_max_load;
+    param->bench_hugepages = bench_hugepages;
     param->skip_benchmarks = skip_benchmarks;
     param->force_all_details = force_all_details;
     param->quiet = quiet;
@@ -18,7 +18,7 @@ enum BenchmarkEntries {
     BENCHMARK_NQUEENS,
     BENCHMARK_FFT,
     BENCHMARK_RAYTRACE,
-    BENCHMARK_IPERF3_SINGLE,
+    BENCHMARK_NETWORK,
     BENCHMARK_SBCPU_SINGLE,
     BENCHMARK_SBCPU_ALL,
     BENCHMARK_SBCPU_QUAD,
@@ -38,6 +38,13 @@ enum BenchmarkEntries {
 #endif
     BENCHMARK_STORAGE,
     BENCHMARK_CACHEMEM,
+    BENCHMARK_STREAM,
+    BENCHMARK_NUMA,
+    BENCHMARK_C2C,
+    BENCHMARK_GEMM,
+    BENCHMARK_RAYTRACE_MT,
+    BENCHMARK_SYNC,
+    BENCHMARK_ALLOC,
     BENCHMARK_N_ENTRIES
 };
 
@@ -59,7 +66,7 @@ void benchmark_gui(void);
 void benchmark_nqueens(void);
 void benchmark_raytrace(void);
 void benchmark_zlib(void);
-void benchmark_iperf3_single(void);
+void benchmark_network(void);
 #if(HARDINFO2_QT5)
 void benchmark_opengl(void);
 #endif
@@ -69,6 +76,101 @@ void benchmark_opengl(void);
 void benchmark_vulkan(void);
 void benchmark_storage(void);
 void benchmark_cachemem(void);
+void benchmark_stream(void);
+void benchmark_numa(void);
+void benchmark_c2c(void);
+void benchmark_gemm(void);
+void benchmark_raytrace_mt(void);
+void benchmark_sync(void);
+void benchmark_alloc(void);
+
+#define BENCH_MAX_TRIALS 32
+#define BENCH_MAX_SLICES 128
+#define BENCH_SLICE_TIME 0.1
+#define BENCH_MIN_SLICES 10   /* --bench-precision: shortest run */
+#define BENCH_MAX_STRETCH 4   /* --bench-precision: longest run, x nominal */
+#define BENCH_MAX_SWEEP 16
+#define BENCH_MAX_CLASSES 4
+#define BENCH_MAX_LATENCY 24 /* 1 KiB .. 8 GiB */
+#define BENCH_MAX_LEVELS 4
+#define BENCH_MAX_NUMA 8
+#define BENCH_MAX_NODES 1024 /* node ids of the online mask */
+#define BENCH_MAX_C2C 32
+
+/* Storage R/W Speed tests, sequential 1 MiB and random 4 KiB */
+enum {
+    BENCH_STORAGE_SEQ_READ,
+    BENCH_STORAGE_SEQ_WRITE,
+    BENCH_STORAGE_READ_QD1,
+    BENCH_STORAGE_READ_QD4,
+    BENCH_STORAGE_READ_QD32,
+    BENCH_STORAGE_WRITE_QD1,
+    BENCH_STORAGE_WRITE_QD4,
+    BENCH_STORAGE_WRITE_QD32,
+    BENCH_STORAGE_TESTS
+};
+
+/* Internal Network Speed tests, Gbit/s; the last three with --bench-zerocopy */
+enum {
+    BENCH_NET_TCP,          /* one stream */
+    BENCH_NET_TCP_STREAMS,
+    BENCH_NET_UDP_STREAMS,
+    BENCH_NET_UNIX_STREAMS,
+    BENCH_NET_TCP_ZEROCOPY, /* MSG_ZEROCOPY */
+    BENCH_NET_TCP_SENDFILE,
+    BENCH_NET_TCP_SPLICE,   /* vmsplice() to a pipe, splice() to the socket */
+    BENCH_NET_TESTS
+};
+
+/* Internal Network Speed round trips */
+enum {
+    BENCH_NET_RTT_TCP,
+    BENCH_NET_RTT_UDP,
+    BENCH_NET_RTT_UNIX,
+    BENCH_NET_RTTS
+};
+
+/* CryptoHash code paths, see hash_isa.c */
+enum {
+    BENCH_HASH_SCALAR,
+    BENCH_HASH_MB4,    /* multi-buffer, SSE2 or NEON */
+    BENCH_HASH_AVX2,   /* multi-buffer x8 */
+    BENCH_HASH_AVX512, /* multi-buffer x16 */
+    BENCH_HASH_SHA_NI,
+    BENCH_HASH_ARMV8,
+    BENCH_HASH_PATHS
+};
+enum { BENCH_HASH_SHA1, BENCH_HASH_SHA256, BENCH_HASHES };
+
+/* CPU Synchronization primitives */
+enum {
+    BENCH_SYNC_ATOMIC_SHARED,
+    BENCH_SYNC_ATOMIC_PADDED,
+    BENCH_SYNC_GMUTEX,
+    BENCH_SYNC_MUTEX,
+    BENCH_SYNC_RWLOCK,
+    BENCH_SYNC_TICKET,
+    BENCH_SYNC_TESTS
+};
+
+/* Memory Allocator patterns */
+enum { BENCH_ALLOC_CHURN, BENCH_ALLOC_CROSS, BENCH_ALLOC_MIXED, BENCH_ALLOC_TESTS };
+
+/* FPU GEMM precisions */
+enum { BENCH_GEMM_FP64, BENCH_GEMM_FP32, BENCH_GEMM_PRECISIONS };
+
+/* core to core latency, kinds of cpu pairs */
+enum {
+    BENCH_C2C_SMT,       /* siblings of one core */
+    BENCH_C2C_CCX,       /* sharing the last level cache */
+    BENCH_C2C_CROSS_CCX, /* same socket */
+    BENCH_C2C_SOCKET,
+    BENCH_C2C_KINDS
+};
+
+/* crunch input of the workers: one shared, or a copy each in small,
+ * transparent huge or hugetlbfs pages */
+enum { BENCH_LOCAL_SHARED, BENCH_LOCAL_COPY, BENCH_LOCAL_THP, BENCH_LOCAL_HUGETLB };
 
 typedef struct {
     double result;
@@ -76,6 +178,108 @@ typedef struct {
     int threads_used;
     int revision;
     char extra[512]; /* no \n, ; or | */
+    /* --bench-repeat: result is the median of the trials */
+    int trials;
+    double trial[BENCH_MAX_TRIALS];
+    double median, min, max, stddev, ci95;
+    /* benchmark_crunch_for(): completions per time slice, relative to
+     * the run average, to show boost/throttling during the run */
+    int slices;
+    double slice_time;
+    float slice[BENCH_MAX_SLICES];
+    double sustained_ratio; /* second half vs first second */
+    double imbalance;       /* (max - min) / max of per thread completions */
+    /* --bench-sweep: completions/s at 1, 2, 4 ... threads */
+    int sweep_steps;
+    int sweep_threads[BENCH_MAX_SWEEP];
+    double sweep_rate[BENCH_MAX_SWEEP];
+    int sweep_knee;         /* threads after which scaling stops paying */
+    /* --bench-classes: result pinned to each core class of a hybrid cpu */
+    int classes;
+    char class_name[BENCH_MAX_CLASSES][16];
+    double class_result[BENCH_MAX_CLASSES];
+    /* --bench-counters: all workers of the run, ratios are -1 if unknown */
+    int counters;           /* 1 read, -1 not available */
+    double ipc;             /* instructions per cycle */
+    double mpki;            /* cache misses per 1000 instructions */
+    double cache_miss_rate, branch_miss_rate;
+    double stalled_frontend, stalled_backend; /* of cycles */
+    /* Cache/Memory: ns per dependent load at 1 KiB << i, and the detected
+     * cache sizes, smallest first */
+    int latency_steps;
+    float latency[BENCH_MAX_LATENCY];
+    int cache_levels;
+    int cache_level_kib[BENCH_MAX_LEVELS];
+    /* NUMA matrix: [cpu node][memory node], -1 if the node has no cpus */
+    int numa_nodes;
+    int numa_id[BENCH_MAX_NUMA];                          /* node ids, may be sparse */
+    float numa_latency[BENCH_MAX_NUMA][BENCH_MAX_NUMA];   /* ns */
+    float numa_bandwidth[BENCH_MAX_NUMA][BENCH_MAX_NUMA]; /* GB/s */
+    /* core to core: median one way ns of each kind of pair, -1 if none;
+     * matrix by core (unit cpu >= 0) or by CCX (unit cpu -1) */
+    int c2c_units;
+    double c2c_kind[BENCH_C2C_KINDS];
+    int c2c_unit_cpu[BENCH_MAX_C2C];
+    int c2c_unit_group[BENCH_MAX_C2C];
+    int c2c_unit_socket[BENCH_MAX_C2C];
+    float c2c_latency[BENCH_MAX_C2C][BENCH_MAX_C2C]; /* ns */
+    /* Storage: by test, -1 if not run; latency p50, p99, p99.9 in usec */
+    int storage_tests;
+    float storage_iops[BENCH_STORAGE_TESTS];
+    float storage_mbs[BENCH_STORAGE_TESTS];
+    float storage_lat[BENCH_STORAGE_TESTS][3];
+    /* Internal Network Speed: Gbit/s by test, -1 if not run; round trip
+     * p50, p99, p99.9 in usec of small messages */
+    int net_tests;
+    int net_streams;
+    float net_gbits[BENCH_NET_TESTS];
+    float net_udp_loss; /* percent */
+    float net_rtt[BENCH_NET_RTTS][3];
+    /* CryptoHash: SHA-1 and SHA-256 MB/s on all threads by code path,
+     * -1 where the cpu does not have it; result stays the scalar mix */
+    int hash_paths;
+    float hash_mbs[BENCH_HASHES][BENCH_HASH_PATHS];
+    /* FPU GEMM: GFLOPS by precision on one and on all threads, and the
+     * peak of the same cores at max frequency, -1 if not known */
+    int gemm;
+    float gemm_gflops[BENCH_GEMM_PRECISIONS][2];
+    float gemm_peak[BENCH_GEMM_PRECISIONS][2];
+    /* CPU Synchronization: Mops/s and min/max per thread fairness by
+     * primitive at each sweep_threads step */
+    int sync_tests;
+    float sync_mops[BENCH_SYNC_TESTS][BENCH_MAX_SWEEP];
+    float sync_fair[BENCH_SYNC_TESTS][BENCH_MAX_SWEEP];
+    /* Memory Allocator: Mops/s by pattern on one and on all threads, RSS
+     * growth in MiB of the all threads run, peak and still held after */
+    int alloc_tests;
+    float alloc_mops[BENCH_ALLOC_TESTS][2];
+    float alloc_rss[BENCH_ALLOC_TESTS][2];
+    /* energy of the run (all trials), power_w 0 if no source readable */
+    double energy_j;
+    float power_w;
+    float score_per_watt;
+    char power_source[16];
+    /* sampled during the run: samples, 0 if no source; MHz min/avg/max
+     * over all cpus, peak cpu temperature in C (-1 unknown) */
+    int telemetry;
+    float freq_mhz[3];
+    float temp_peak;
+    int throttled;
+    /* --bench-precision: relative 95% CI of the mean completions per time
+     * slice when the run stopped, 0 for a fixed length run */
+    float precision;
+    /* --bench-isolate: cpus fenced to, 0 if not isolated; busy % of them
+     * by other processes just before the run, 1 minute load average and
+     * involuntary context switches of the run */
+    int isolated_cpus;
+    float noise;
+    float load_avg;
+    int nivcsw;
+    /* crunch runs: completions whose check failed, summed over the workers
+     * (and sweep steps); input a BENCH_LOCAL_* if every worker had its own
+     * copy of it, 0 if they shared one */
+    int errors;
+    int local_input;
 } bench_value;
 
 #define EMPTY_BENCH_VALUE {-1.0f,0,0,-1,""}
@@ -94,15 +298,139 @@ bench_value benchmark_parallel(gint n_threads, gpointer callback, gpointer callb
 
 bench_value benchmark_crunch_for(float seconds, gint n_threads,
                                gpointer callback, gpointer callback_data);
+/* as benchmark_crunch_for(), but every worker first copies size bytes of
+ * data into memory of its own, and callback gets that copy; a callback
+ * returning non-NULL counts as a failed check in errors */
+bench_value benchmark_crunch_for_local(float seconds, gint n_threads,
+                               gpointer callback, gconstpointer data, gsize size);
+
+/* sets sweep_knee from sweep_threads/sweep_rate */
+void benchmark_sweep_knee(bench_value *r);
+/* --bench-budget: seconds the current run may take, 0 for no limit */
+double benchmark_run_budget(void);
 
 extern bench_value bench_results[BENCHMARK_N_ENTRIES];
 
+/* in bench_workers.c */
+
+/* persistent pool, one worker pinned per logical cpu.
+ * bench_workers_start() returns when all n_threads workers have
+ * passed the start barrier; func(data, thread_number) is then running
+ * on each of them. bench_workers_wait() blocks until all return. */
+typedef void (*bench_worker_func)(gpointer data, gint thread_number);
+gint bench_workers_start(gint n_threads, bench_worker_func func, gpointer data);
+void bench_workers_wait(void);
+gint bench_workers_cpu(gint thread_number); /* -1 if not pinned */
+gint bench_workers_node(gint thread_number); /* NUMA node, -1 if not known */
+void bench_workers_free(void);
+guint bench_workers_jobs(void); /* jobs started so far */
+/* cpus the workers of the last job are pinned to, 0 if none is pinned */
+gint bench_workers_active_cpus(gint *cpus, gint max);
+/* cores/threads the workers run on, for n_threads 0 and -1 */
+void bench_workers_cores_threads(gint *cores, gint *threads);
+
+/* hybrid cpus: core classes, fastest first, 0 if not hybrid */
+gint bench_core_classes(void);
+const gchar *bench_core_class_name(gint class_id);
+/* pin workers to one core class, -1 for all cpus */
+void bench_workers_set_class(gint class_id);
+/* pin workers to the cpus of one NUMA node, -1 for all; returns the
+ * number of cpus, 0 if the node has none */
+gint bench_workers_set_node(gint node_id);
+/* ids of the online NUMA nodes, may be sparse; 0 if not NUMA */
+gint bench_online_nodes(gint *nodes, gint max);
+/* pin worker N to cpus[N], n_cpus 0 to go back to class/node */
+gint bench_workers_set_cpus(const gint *cpus, gint n_cpus);
+/* confine the process and the pool to the allowed cpus of a "0-3,8"
+ * list; returns their number, 0 if none (nothing changed) */
+gint bench_workers_fence(const gchar *list);
+
+/* work stealing over tasks 0 .. n_tasks-1, one deque per worker;
+ * bench_steal_next() is FALSE once every deque is empty */
+typedef struct bench_steal bench_steal;
+bench_steal *bench_steal_new(gint n_queues, guint n_tasks);
+gboolean bench_steal_next(bench_steal *s, gint queue, guint *task);
+guint bench_steal_count(bench_steal *s); /* steals so far */
+void bench_steal_free(bench_steal *s);
+
+/* in bench_counters.c */
+enum {
+    BENCH_COUNTER_CYCLES,
+    BENCH_COUNTER_INSTRUCTIONS,
+    BENCH_COUNTER_CACHE_REFS,
+    BENCH_COUNTER_CACHE_MISSES,
+    BENCH_COUNTER_BRANCHES,
+    BENCH_COUNTER_BRANCH_MISSES,
+    BENCH_COUNTER_STALLED_FRONTEND,
+    BENCH_COUNTER_STALLED_BACKEND,
+    BENCH_COUNTERS
+};
+typedef struct {
+    int fd[BENCH_COUNTERS];
+    guint64 value[BENCH_COUNTERS];
+    guint valid; /* bit per counter */
+} bench_counters;
+/* per thread; pmu_type 0 for the default cpu PMU */
+void bench_counters_open(bench_counters *c, gint pmu_type);
+void bench_counters_enable(bench_counters *c);
+void bench_counters_close(bench_counters *c);
+void bench_counters_add(bench_counters *sum, const bench_counters *c, gboolean first);
+void bench_counters_result(bench_value *r, const bench_counters *sum);
+/* in bench_workers.c: sum of the last job, FALSE if run without counters */
+gboolean bench_workers_counters(bench_counters *sum);
+
+/* in bench_energy.c: powercap/RAPL or hwmon, read around a run;
+ * start is NULL if nothing is readable, stop fills energy_j, power_w,
+ * score_per_watt (from result) and power_source, and frees */
+typedef struct bench_energy bench_energy;
+bench_energy *bench_energy_start(void);
+void bench_energy_stop(bench_energy *e, bench_value *r);
+
+/* in bench_telemetry.c: cpufreq and cpu temperature sampler thread,
+ * stop fills telemetry, freq_mhz, temp_peak and throttled, and frees */
+typedef struct bench_telemetry bench_telemetry;
+bench_telemetry *bench_telemetry_start(void);
+void bench_telemetry_stop(bench_telemetry *t, bench_value *r);
+
+/* in bench_isolate.c: --bench-isolate, NULL if not set; start fences the
+ * cpus and measures the background load, refused is TRUE (r->extra says
+ * why) above --bench-max-load, stop fills isolated_cpus, noise, load_avg
+ * and nivcsw, and frees */
+#define BENCH_NOISE_WARN 10 /* busy %, warned about and marked above */
+typedef struct bench_isolate bench_isolate;
+bench_isolate *bench_isolate_start(void);
+gboolean bench_isolate_refused(bench_isolate *iso, bench_value *r);
+void bench_isolate_stop(bench_isolate *iso, bench_value *r);
+
 /* in bench_util.c */
 
 /* guarantee a minimum size of data
  * or return null */
 gchar *get_test_data(gsize min_size);
 char *md5_digest_str(const char *data, unsigned int len);
+/* median, min/max, stddev and 95% CI half-width from trial[0..trials-1] */
+void bench_value_stats(bench_value *r);
+double bench_rel_ci95(const double *v, int n);
+/* monotonic clock */
+gint64 bench_time_usec(void);
+gint64 bench_time_nsec(void);
+/* memory latency: build a random pointer chain over buf, then follow it */
+void **bench_chase_chain(gchar *buf, gsize size);
+double bench_chase_ns(void **start);
+/* last level cache of cpu0 in bytes, 0 if not known */
+gsize bench_llc_bytes(void);
+/* coretemp, k10temp, zenpower, *cpu*, *soc* */
+gboolean bench_hwmon_cpu_chip(const gchar *name);
+/* --bench-hugepages: copy of data first touched by the calling thread,
+ * kind is a BENCH_LOCAL_*; NULL if it could not be mapped */
+gpointer bench_local_copy(gconstpointer data, gsize size, gsize *mapped, gint *kind);
+void bench_local_free(gpointer p, gsize mapped); /* nothing if mapped is 0 */
+
+/* in hash_isa.c */
+/* fills hash_mbs, returns the number of paths with a wrong digest */
+gint bench_hash_paths(bench_value *r, const gchar *data, gsize size);
+gint bench_hash_best_path(const bench_value *r, gint hash);
+const gchar *bench_hash_path_name(gint path);
 //#define bench_msg(msg, ...)  fprintf (stderr, "[%s] " msg "\n", __FUNCTION__, ##__VA_ARGS__)
 
 #endif /* __BENCHMARK_H__ */
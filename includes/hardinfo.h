@@ -64,10 +64,25 @@ struct _ProgramParameters {
   int fmt_opts;
   gint     report_format;
   gint     max_bench_results;
+  gint     bench_repeat;
+  gint     bench_warmup;
+  gint     bench_batch;
+  gint     bench_gap;
+  gint     bench_sweep;
+  gint     bench_classes;
+  gint     bench_counters;
   gint     topiccached;
   gchar   *topic;
   gchar   *run_benchmark;
   gchar   *bench_user_note;
+  gchar   *bench_storage;
+  gint     bench_zerocopy;
+  gint     bench_nqueens_depth;
+  gdouble  bench_precision;
+  gint     bench_budget;
+  gchar   *bench_isolate;
+  gint     bench_max_load;
+  gchar   *bench_hugepages;
   gchar   *result_format;
   gchar   *path_lib;
   gchar   *path_data;
@@ -48,15 +48,455 @@ static gchar *benchmark_include_results(bench_value result,
 /* ModuleEntry entries, scan_*(), callback_*(), etc. */
 #include "benchmark/benches.c"
 
+/* optional "| key=value; ..." fields after extra, always '.' as decimal point */
+static char *bench_value_fields_to_str(const bench_value *r)
+{
+    char buf[G_ASCII_DTOSTR_BUF_SIZE];
+    char *fields = NULL;
+    int i;
+
+#define FIELD_DOUBLE(name, value) \
+    fields = appf(fields, "; ", "%s=%s", name, g_ascii_formatd(buf, sizeof(buf), "%.4f", value))
+
+    if (r->trials > 1) {
+        fields = appf(fields, "; ", "trials=%d", r->trials);
+        FIELD_DOUBLE("median", r->median);
+        FIELD_DOUBLE("min", r->min);
+        FIELD_DOUBLE("max", r->max);
+        FIELD_DOUBLE("stddev", r->stddev);
+        FIELD_DOUBLE("ci95", r->ci95);
+        fields = appf(fields, "; ", "t=%s", g_ascii_formatd(buf, sizeof(buf), "%.4f", r->trial[0]));
+        for (i = 1; i < r->trials; i++)
+            fields = appf(fields, " ", "%s", g_ascii_formatd(buf, sizeof(buf), "%.4f", r->trial[i]));
+    }
+
+    if (r->imbalance > 0)
+        FIELD_DOUBLE("imbalance", r->imbalance);
+    if (r->slices > 0) {
+        FIELD_DOUBLE("slice_time", r->slice_time);
+        if (r->precision > 0)
+            FIELD_DOUBLE("precision", r->precision);
+        FIELD_DOUBLE("sustained", r->sustained_ratio);
+        fields = appf(fields, "; ", "series=%s", g_ascii_formatd(buf, sizeof(buf), "%.3f", r->slice[0]));
+        for (i = 1; i < r->slices; i++)
+            fields = appf(fields, " ", "%s", g_ascii_formatd(buf, sizeof(buf), "%.3f", r->slice[i]));
+    }
+
+    if (r->sweep_steps > 0) {
+        fields = appf(fields, "; ", "knee=%d", r->sweep_knee);
+        fields = appf(fields, "; ", "sweep=%d:%s", r->sweep_threads[0],
+                      g_ascii_formatd(buf, sizeof(buf), "%.4f", r->sweep_rate[0]));
+        for (i = 1; i < r->sweep_steps; i++)
+            fields = appf(fields, " ", "%d:%s", r->sweep_threads[i],
+                          g_ascii_formatd(buf, sizeof(buf), "%.4f", r->sweep_rate[i]));
+    }
+
+    for (i = 0; i < r->classes; i++)
+        fields = appf(fields, "; ", "class=%s:%s", r->class_name[i],
+                      g_ascii_formatd(buf, sizeof(buf), "%.4f", r->class_result[i]));
+
+    if (r->counters)
+        fields = appf(fields, "; ", "counters=%d", r->counters);
+    if (r->counters > 0) {
+        FIELD_DOUBLE("ipc", r->ipc);
+        FIELD_DOUBLE("mpki", r->mpki);
+        FIELD_DOUBLE("cmiss", r->cache_miss_rate);
+        FIELD_DOUBLE("brmiss", r->branch_miss_rate);
+        FIELD_DOUBLE("stallfe", r->stalled_frontend);
+        FIELD_DOUBLE("stallbe", r->stalled_backend);
+    }
+
+    if (r->power_w > 0) {
+        FIELD_DOUBLE("energy", r->energy_j);
+        FIELD_DOUBLE("watts", r->power_w);
+        FIELD_DOUBLE("per_watt", r->score_per_watt);
+        fields = appf(fields, "; ", "power_src=%s", r->power_source);
+    }
+
+    if (r->isolated_cpus > 0) {
+        fields = appf(fields, "; ", "isolated=%d", r->isolated_cpus);
+        FIELD_DOUBLE("noise", r->noise);
+        FIELD_DOUBLE("load", r->load_avg);
+        fields = appf(fields, "; ", "nivcsw=%d", r->nivcsw);
+    }
+
+    if (r->errors > 0)
+        fields = appf(fields, "; ", "errors=%d", r->errors);
+    if (r->local_input > 0)
+        fields = appf(fields, "; ", "local=%d", r->local_input);
+
+    /* clocks min avg max, peak temperature */
+    if (r->telemetry > 0) {
+        fields = appf(fields, "; ", "telemetry=%d", r->telemetry);
+        fields = appf(fields, "; ", "mhz=%s", g_ascii_formatd(buf, sizeof(buf), "%.0f", r->freq_mhz[0]));
+        for (i = 1; i < 3; i++)
+            fields = appf(fields, " ", "%s", g_ascii_formatd(buf, sizeof(buf), "%.0f", r->freq_mhz[i]));
+        FIELD_DOUBLE("temp", r->temp_peak);
+        fields = appf(fields, "; ", "throttled=%d", r->throttled);
+    }
+
+    if (r->latency_steps > 0) {
+        fields = appf(fields, "; ", "latency=%s", g_ascii_formatd(buf, sizeof(buf), "%.2f", r->latency[0]));
+        for (i = 1; i < r->latency_steps; i++)
+            fields = appf(fields, " ", "%s", g_ascii_formatd(buf, sizeof(buf), "%.2f", r->latency[i]));
+    }
+    if (r->cache_levels > 0) {
+        fields = appf(fields, "; ", "levels=%d", r->cache_level_kib[0]);
+        for (i = 1; i < r->cache_levels; i++)
+            fields = appf(fields, " ", "%d", r->cache_level_kib[i]);
+    }
+
+    /* row by row, [cpu node][memory node] */
+    if (r->numa_nodes > 0) {
+        int n = r->numa_nodes * r->numa_nodes;
+        fields = appf(fields, "; ", "numa=%d", r->numa_nodes);
+        fields = appf(fields, "; ", "numa_id=%d", r->numa_id[0]);
+        for (i = 1; i < r->numa_nodes; i++)
+            fields = appf(fields, " ", "%d", r->numa_id[i]);
+        fields = appf(fields, "; ", "numa_lat=%s", g_ascii_formatd(buf, sizeof(buf), "%.1f", r->numa_latency[0][0]));
+        for (i = 1; i < n; i++)
+            fields = appf(fields, " ", "%s", g_ascii_formatd(buf, sizeof(buf), "%.1f",
+                          r->numa_latency[i / r->numa_nodes][i % r->numa_nodes]));
+        fields = appf(fields, "; ", "numa_bw=%s", g_ascii_formatd(buf, sizeof(buf), "%.2f", r->numa_bandwidth[0][0]));
+        for (i = 1; i < n; i++)
+            fields = appf(fields, " ", "%s", g_ascii_formatd(buf, sizeof(buf), "%.2f",
+                          r->numa_bandwidth[i / r->numa_nodes][i % r->numa_nodes]));
+    }
+
+    /* by test: IOPS, MB/s and p50 p99 p99.9 usec */
+    if (r->storage_tests > 0) {
+        fields = appf(fields, "; ", "sto_iops=%s", g_ascii_formatd(buf, sizeof(buf), "%.0f", r->storage_iops[0]));
+        for (i = 1; i < r->storage_tests; i++)
+            fields = appf(fields, " ", "%s", g_ascii_formatd(buf, sizeof(buf), "%.0f", r->storage_iops[i]));
+        fields = appf(fields, "; ", "sto_mbs=%s", g_ascii_formatd(buf, sizeof(buf), "%.2f", r->storage_mbs[0]));
+        for (i = 1; i < r->storage_tests; i++)
+            fields = appf(fields, " ", "%s", g_ascii_formatd(buf, sizeof(buf), "%.2f", r->storage_mbs[i]));
+        fields = appf(fields, "; ", "sto_lat=%s", g_ascii_formatd(buf, sizeof(buf), "%.1f", r->storage_lat[0][0]));
+        for (i = 1; i < 3 * r->storage_tests; i++)
+            fields = appf(fields, " ", "%s", g_ascii_formatd(buf, sizeof(buf), "%.1f",
+                          r->storage_lat[i / 3][i % 3]));
+    }
+
+    /* units as cpu:group:socket, then the matrix row by row */
+    if (r->c2c_units > 0) {
+        int n = r->c2c_units * r->c2c_units;
+        fields = appf(fields, "; ", "c2c=%s", g_ascii_formatd(buf, sizeof(buf), "%.1f", r->c2c_kind[0]));
+        for (i = 1; i < BENCH_C2C_KINDS; i++)
+            fields = appf(fields, " ", "%s", g_ascii_formatd(buf, sizeof(buf), "%.1f", r->c2c_kind[i]));
+        fields = appf(fields, "; ", "c2c_units=%d:%d:%d", r->c2c_unit_cpu[0],
+                      r->c2c_unit_group[0], r->c2c_unit_socket[0]);
+        for (i = 1; i < r->c2c_units; i++)
+            fields = appf(fields, " ", "%d:%d:%d", r->c2c_unit_cpu[i],
+                          r->c2c_unit_group[i], r->c2c_unit_socket[i]);
+        fields = appf(fields, "; ", "c2c_lat=%s", g_ascii_formatd(buf, sizeof(buf), "%.1f", r->c2c_latency[0][0]));
+        for (i = 1; i < n; i++)
+            fields = appf(fields, " ", "%s", g_ascii_formatd(buf, sizeof(buf), "%.1f",
+                          r->c2c_latency[i / r->c2c_units][i % r->c2c_units]));
+    }
+
+    /* Gbit/s by test, then p50 p99 p99.9 usec of each round trip */
+    if (r->net_tests > 0) {
+        fields = appf(fields, "; ", "net=%s", g_ascii_formatd(buf, sizeof(buf), "%.2f", r->net_gbits[0]));
+        for (i = 1; i < r->net_tests; i++)
+            fields = appf(fields, " ", "%s", g_ascii_formatd(buf, sizeof(buf), "%.2f", r->net_gbits[i]));
+        fields = appf(fields, "; ", "net_streams=%d", r->net_streams);
+        FIELD_DOUBLE("net_loss", r->net_udp_loss);
+        fields = appf(fields, "; ", "net_rtt=%s", g_ascii_formatd(buf, sizeof(buf), "%.2f", r->net_rtt[0][0]));
+        for (i = 1; i < 3 * BENCH_NET_RTTS; i++)
+            fields = appf(fields, " ", "%s", g_ascii_formatd(buf, sizeof(buf), "%.2f",
+                          r->net_rtt[i / 3][i % 3]));
+    }
+
+    /* SHA-1 MB/s by code path, then SHA-256 */
+    if (r->hash_paths > 0) {
+        fields = appf(fields, "; ", "hash=%s", g_ascii_formatd(buf, sizeof(buf), "%.0f", r->hash_mbs[0][0]));
+        for (i = 1; i < BENCH_HASHES * r->hash_paths; i++)
+            fields = appf(fields, " ", "%s", g_ascii_formatd(buf, sizeof(buf), "%.0f",
+                          r->hash_mbs[i / r->hash_paths][i % r->hash_paths]));
+    }
+
+    /* GEMM FP64 single, all threads, then FP32 */
+    if (r->gemm > 0) {
+        fields = appf(fields, "; ", "gemm=%s", g_ascii_formatd(buf, sizeof(buf), "%.2f", r->gemm_gflops[0][0]));
+        for (i = 1; i < 2 * BENCH_GEMM_PRECISIONS; i++)
+            fields = appf(fields, " ", "%s", g_ascii_formatd(buf, sizeof(buf), "%.2f",
+                          r->gemm_gflops[i / 2][i % 2]));
+        fields = appf(fields, "; ", "gemm_peak=%s", g_ascii_formatd(buf, sizeof(buf), "%.2f", r->gemm_peak[0][0]));
+        for (i = 1; i < 2 * BENCH_GEMM_PRECISIONS; i++)
+            fields = appf(fields, " ", "%s", g_ascii_formatd(buf, sizeof(buf), "%.2f",
+                          r->gemm_peak[i / 2][i % 2]));
+    }
+
+    /* synchronization by primitive, each over the sweep steps */
+    if (r->sync_tests > 0 && r->sweep_steps > 0) {
+        int n = r->sweep_steps;
+        fields = appf(fields, "; ", "sync=%s", g_ascii_formatd(buf, sizeof(buf), "%.3f", r->sync_mops[0][0]));
+        for (i = 1; i < BENCH_SYNC_TESTS * n; i++)
+            fields = appf(fields, " ", "%s", g_ascii_formatd(buf, sizeof(buf), "%.3f",
+                          r->sync_mops[i / n][i % n]));
+        fields = appf(fields, "; ", "sync_fair=%s", g_ascii_formatd(buf, sizeof(buf), "%.3f", r->sync_fair[0][0]));
+        for (i = 1; i < BENCH_SYNC_TESTS * n; i++)
+            fields = appf(fields, " ", "%s", g_ascii_formatd(buf, sizeof(buf), "%.3f",
+                          r->sync_fair[i / n][i % n]));
+    }
+
+    /* allocator by pattern, one and all threads */
+    if (r->alloc_tests > 0) {
+        fields = appf(fields, "; ", "alloc=%s", g_ascii_formatd(buf, sizeof(buf), "%.3f", r->alloc_mops[0][0]));
+        for (i = 1; i < 2 * BENCH_ALLOC_TESTS; i++)
+            fields = appf(fields, " ", "%s", g_ascii_formatd(buf, sizeof(buf), "%.3f",
+                          r->alloc_mops[i / 2][i % 2]));
+        fields = appf(fields, "; ", "alloc_rss=%s", g_ascii_formatd(buf, sizeof(buf), "%.1f", r->alloc_rss[0][0]));
+        for (i = 1; i < 2 * BENCH_ALLOC_TESTS; i++)
+            fields = appf(fields, " ", "%s", g_ascii_formatd(buf, sizeof(buf), "%.1f",
+                          r->alloc_rss[i / 2][i % 2]));
+    }
+
+#undef FIELD_DOUBLE
+
+    return fields;
+}
+
+static void bench_value_fields_from_str(bench_value *r, const char *str)
+{
+    gchar **fields, **f, **t, *v;
+    int i;
+
+    fields = g_strsplit(str, ";", 0);
+    for (f = fields; *f; f++) {
+        g_strstrip(*f);
+        if (!(v = strchr(*f, '=')))
+            continue;
+        *v++ = 0;
+
+        if (SEQ(*f, "trials")) {
+            r->trials = CLAMP(atoi(v), 0, BENCH_MAX_TRIALS);
+        } else if (SEQ(*f, "median")) {
+            r->median = g_ascii_strtod(v, NULL);
+        } else if (SEQ(*f, "min")) {
+            r->min = g_ascii_strtod(v, NULL);
+        } else if (SEQ(*f, "max")) {
+            r->max = g_ascii_strtod(v, NULL);
+        } else if (SEQ(*f, "stddev")) {
+            r->stddev = g_ascii_strtod(v, NULL);
+        } else if (SEQ(*f, "ci95")) {
+            r->ci95 = g_ascii_strtod(v, NULL);
+        } else if (SEQ(*f, "t")) {
+            t = g_strsplit(v, " ", BENCH_MAX_TRIALS);
+            for (i = 0; t[i]; i++)
+                r->trial[i] = g_ascii_strtod(t[i], NULL);
+            g_strfreev(t);
+        } else if (SEQ(*f, "imbalance")) {
+            r->imbalance = g_ascii_strtod(v, NULL);
+        } else if (SEQ(*f, "precision")) {
+            r->precision = g_ascii_strtod(v, NULL);
+        } else if (SEQ(*f, "slice_time")) {
+            r->slice_time = g_ascii_strtod(v, NULL);
+        } else if (SEQ(*f, "sustained")) {
+            r->sustained_ratio = g_ascii_strtod(v, NULL);
+        } else if (SEQ(*f, "series")) {
+            t = g_strsplit(v, " ", BENCH_MAX_SLICES);
+            for (i = 0; t[i]; i++)
+                r->slice[i] = g_ascii_strtod(t[i], NULL);
+            r->slices = i;
+            g_strfreev(t);
+        } else if (SEQ(*f, "knee")) {
+            r->sweep_knee = atoi(v);
+        } else if (SEQ(*f, "sweep")) {
+            t = g_strsplit(v, " ", BENCH_MAX_SWEEP);
+            for (i = 0; t[i]; i++) {
+                gchar *rate = strchr(t[i], ':');
+                r->sweep_threads[i] = atoi(t[i]);
+                r->sweep_rate[i] = rate ? g_ascii_strtod(rate + 1, NULL) : 0;
+            }
+            r->sweep_steps = i;
+            g_strfreev(t);
+        } else if (SEQ(*f, "class") && r->classes < BENCH_MAX_CLASSES) {
+            gchar *result = strrchr(v, ':');
+            if (!result) continue;
+            *result++ = 0;
+            g_strlcpy(r->class_name[r->classes], v, sizeof(r->class_name[0]));
+            r->class_result[r->classes++] = g_ascii_strtod(result, NULL);
+        } else if (SEQ(*f, "energy")) {
+            r->energy_j = g_ascii_strtod(v, NULL);
+        } else if (SEQ(*f, "watts")) {
+            r->power_w = g_ascii_strtod(v, NULL);
+        } else if (SEQ(*f, "per_watt")) {
+            r->score_per_watt = g_ascii_strtod(v, NULL);
+        } else if (SEQ(*f, "power_src")) {
+            g_strlcpy(r->power_source, v, sizeof(r->power_source));
+        } else if (SEQ(*f, "isolated")) {
+            r->isolated_cpus = atoi(v);
+        } else if (SEQ(*f, "noise")) {
+            r->noise = g_ascii_strtod(v, NULL);
+        } else if (SEQ(*f, "load")) {
+            r->load_avg = g_ascii_strtod(v, NULL);
+        } else if (SEQ(*f, "nivcsw")) {
+            r->nivcsw = atoi(v);
+        } else if (SEQ(*f, "errors")) {
+            r->errors = atoi(v);
+        } else if (SEQ(*f, "local")) {
+            r->local_input = CLAMP(atoi(v), BENCH_LOCAL_SHARED, BENCH_LOCAL_HUGETLB);
+        } else if (SEQ(*f, "telemetry")) {
+            r->telemetry = atoi(v);
+        } else if (SEQ(*f, "mhz")) {
+            t = g_strsplit(v, " ", 0);
+            for (i = 0; t[i] && i < 3; i++)
+                r->freq_mhz[i] = g_ascii_strtod(t[i], NULL);
+            g_strfreev(t);
+        } else if (SEQ(*f, "temp")) {
+            r->temp_peak = g_ascii_strtod(v, NULL);
+        } else if (SEQ(*f, "throttled")) {
+            r->throttled = atoi(v) != 0;
+        } else if (SEQ(*f, "counters")) {
+            r->counters = CLAMP(atoi(v), -1, 1);
+        } else if (SEQ(*f, "ipc")) {
+            r->ipc = g_ascii_strtod(v, NULL);
+        } else if (SEQ(*f, "mpki")) {
+            r->mpki = g_ascii_strtod(v, NULL);
+        } else if (SEQ(*f, "cmiss")) {
+            r->cache_miss_rate = g_ascii_strtod(v, NULL);
+        } else if (SEQ(*f, "brmiss")) {
+            r->branch_miss_rate = g_ascii_strtod(v, NULL);
+        } else if (SEQ(*f, "stallfe")) {
+            r->stalled_frontend = g_ascii_strtod(v, NULL);
+        } else if (SEQ(*f, "stallbe")) {
+            r->stalled_backend = g_ascii_strtod(v, NULL);
+        } else if (SEQ(*f, "latency")) {
+            t = g_strsplit(v, " ", BENCH_MAX_LATENCY);
+            for (i = 0; t[i]; i++)
+                r->latency[i] = g_ascii_strtod(t[i], NULL);
+            r->latency_steps = i;
+            g_strfreev(t);
+        } else if (SEQ(*f, "levels")) {
+            t = g_strsplit(v, " ", BENCH_MAX_LEVELS);
+            for (i = 0; t[i]; i++)
+                r->cache_level_kib[i] = atoi(t[i]);
+            r->cache_levels = i;
+            g_strfreev(t);
+        } else if (SEQ(*f, "numa")) {
+            r->numa_nodes = CLAMP(atoi(v), 0, BENCH_MAX_NUMA);
+            /* results without numa_id= had nodes 0..n-1 */
+            for (i = 0; i < r->numa_nodes; i++)
+                r->numa_id[i] = i;
+        } else if (SEQ(*f, "numa_id")) {
+            t = g_strsplit(v, " ", 0);
+            for (i = 0; t[i] && i < r->numa_nodes; i++)
+                r->numa_id[i] = atoi(t[i]);
+            g_strfreev(t);
+        } else if (SEQ(*f, "numa_lat") || SEQ(*f, "numa_bw")) {
+            /* numa= comes first */
+            float (*m)[BENCH_MAX_NUMA] = SEQ(*f, "numa_lat") ? r->numa_latency : r->numa_bandwidth;
+            int n = r->numa_nodes * r->numa_nodes;
+            t = g_strsplit(v, " ", 0);
+            for (i = 0; t[i] && i < n; i++)
+                m[i / r->numa_nodes][i % r->numa_nodes] = g_ascii_strtod(t[i], NULL);
+            g_strfreev(t);
+        } else if (SEQ(*f, "sto_iops")) {
+            t = g_strsplit(v, " ", BENCH_STORAGE_TESTS);
+            for (i = 0; t[i]; i++)
+                r->storage_iops[i] = g_ascii_strtod(t[i], NULL);
+            r->storage_tests = i;
+            g_strfreev(t);
+        } else if (SEQ(*f, "sto_mbs")) {
+            t = g_strsplit(v, " ", BENCH_STORAGE_TESTS);
+            for (i = 0; t[i]; i++)
+                r->storage_mbs[i] = g_ascii_strtod(t[i], NULL);
+            g_strfreev(t);
+        } else if (SEQ(*f, "sto_lat")) {
+            t = g_strsplit(v, " ", 0);
+            for (i = 0; t[i] && i < 3 * BENCH_STORAGE_TESTS; i++)
+                r->storage_lat[i / 3][i % 3] = g_ascii_strtod(t[i], NULL);
+            g_strfreev(t);
+        } else if (SEQ(*f, "c2c")) {
+            t = g_strsplit(v, " ", BENCH_C2C_KINDS);
+            for (i = 0; t[i]; i++)
+                r->c2c_kind[i] = g_ascii_strtod(t[i], NULL);
+            g_strfreev(t);
+        } else if (SEQ(*f, "c2c_units")) {
+            t = g_strsplit(v, " ", BENCH_MAX_C2C);
+            for (i = 0; t[i]; i++)
+                if (sscanf(t[i], "%d:%d:%d", &r->c2c_unit_cpu[i], &r->c2c_unit_group[i],
+                           &r->c2c_unit_socket[i]) != 3) break;
+            r->c2c_units = i;
+            g_strfreev(t);
+        } else if (SEQ(*f, "c2c_lat")) {
+            /* c2c_units= comes first */
+            int n = r->c2c_units * r->c2c_units;
+            t = g_strsplit(v, " ", 0);
+            for (i = 0; t[i] && i < n; i++)
+                r->c2c_latency[i / r->c2c_units][i % r->c2c_units] = g_ascii_strtod(t[i], NULL);
+            g_strfreev(t);
+        } else if (SEQ(*f, "net")) {
+            t = g_strsplit(v, " ", BENCH_NET_TESTS);
+            for (i = 0; t[i]; i++)
+                r->net_gbits[i] = g_ascii_strtod(t[i], NULL);
+            r->net_tests = i;
+            g_strfreev(t);
+        } else if (SEQ(*f, "net_streams")) {
+            r->net_streams = atoi(v);
+        } else if (SEQ(*f, "net_loss")) {
+            r->net_udp_loss = g_ascii_strtod(v, NULL);
+        } else if (SEQ(*f, "net_rtt")) {
+            t = g_strsplit(v, " ", 0);
+            for (i = 0; t[i] && i < 3 * BENCH_NET_RTTS; i++)
+                r->net_rtt[i / 3][i % 3] = g_ascii_strtod(t[i], NULL);
+            g_strfreev(t);
+        } else if (SEQ(*f, "hash")) {
+            int n;
+            t = g_strsplit(v, " ", 0);
+            n = MIN(g_strv_length(t) / BENCH_HASHES, BENCH_HASH_PATHS);
+            for (i = 0; i < BENCH_HASHES * n; i++)
+                r->hash_mbs[i / n][i % n] = g_ascii_strtod(t[i], NULL);
+            r->hash_paths = n;
+            g_strfreev(t);
+        } else if (SEQ(*f, "gemm")) {
+            t = g_strsplit(v, " ", 0);
+            for (i = 0; t[i] && i < 2 * BENCH_GEMM_PRECISIONS; i++)
+                r->gemm_gflops[i / 2][i % 2] = g_ascii_strtod(t[i], NULL);
+            r->gemm = 1;
+            g_strfreev(t);
+        } else if (SEQ(*f, "gemm_peak")) {
+            t = g_strsplit(v, " ", 0);
+            for (i = 0; t[i] && i < 2 * BENCH_GEMM_PRECISIONS; i++)
+                r->gemm_peak[i / 2][i % 2] = g_ascii_strtod(t[i], NULL);
+            g_strfreev(t);
+        } else if (SEQ(*f, "sync") || SEQ(*f, "sync_fair")) {
+            int n;
+            float (*m)[BENCH_MAX_SWEEP] = SEQ(*f, "sync") ? r->sync_mops : r->sync_fair;
+            t = g_strsplit(v, " ", 0);
+            n = MIN(g_strv_length(t) / BENCH_SYNC_TESTS, BENCH_MAX_SWEEP);
+            for (i = 0; i < BENCH_SYNC_TESTS * n; i++)
+                m[i / n][i % n] = g_ascii_strtod(t[i], NULL);
+            if (n > 0) r->sync_tests = BENCH_SYNC_TESTS;
+            g_strfreev(t);
+        } else if (SEQ(*f, "alloc") || SEQ(*f, "alloc_rss")) {
+            float (*m)[2] = SEQ(*f, "alloc") ? r->alloc_mops : r->alloc_rss;
+            t = g_strsplit(v, " ", 0);
+            for (i = 0; t[i] && i < 2 * BENCH_ALLOC_TESTS; i++)
+                m[i / 2][i % 2] = g_ascii_strtod(t[i], NULL);
+            r->alloc_tests = BENCH_ALLOC_TESTS;
+            g_strfreev(t);
+        }
+    }
+    g_strfreev(fields);
+}
+
 char *bench_value_to_str(bench_value r)
 {
+    char *fields = bench_value_fields_to_str(&r);
     gboolean has_rev = (r.revision >= 0);
     gboolean has_extra = (r.extra[0] != 0);
     char *ret = g_strdup_printf("%lf; %lf; %d", r.result, r.elapsed_time, r.threads_used);
-    if (has_rev || has_extra)
+    if (has_rev || has_extra || fields)
         ret = appf(ret, "; ", "%d", r.revision);
     if (has_extra)
         ret = appf(ret, "; ", "%s", r.extra);
+    else if (fields)
+        ret = appf(ret, NULL, "%s", "; "); /* empty extra */
+    if (fields)
+        ret = appf(ret, "| ", "%s", fields);
+    g_free(fields);
     return ret;
 }
 
@@ -89,6 +529,9 @@ bench_value bench_value_from_str(const char *str)
         if (c >= 5) {
             strcpy(ret.extra, extra);
         }
+        if ((p = strchr(str, '|'))) {
+            bench_value_fields_from_str(&ret, p + 1);
+        }
     }
     return ret;
 }
@@ -96,51 +539,173 @@ bench_value bench_value_from_str(const char *str)
 typedef struct _ParallelBenchTask ParallelBenchTask;
 
 struct _ParallelBenchTask {
-    gint thread_number;
     guint start, end;
     gpointer data, callback;
     gint *stop;
+    double count;
+    gpointer return_value;
+    gint64 slice_usec;
+    guint slices[BENCH_MAX_SLICES];
+    guint errors;
+    gsize local_size, local_mapped;
+    gint local_kind;
 };
 
-static gpointer benchmark_crunch_for_dispatcher(gpointer data)
+static void benchmark_crunch_for_dispatcher(gpointer data, gint thread_number)
 {
-    ParallelBenchTask *pbt = (ParallelBenchTask *)data;
+    ParallelBenchTask *pbt = (ParallelBenchTask *)data + thread_number;
     gpointer (*callback)(void *data, gint thread_number);
-    gpointer return_value = g_malloc(sizeof(double));
+    gint64 start = bench_time_usec(), slice;
     int count = 0;
+    guint errors = 0;
 
     if ((callback = pbt->callback)) {
         while (!g_atomic_int_get(pbt->stop)) {
-            callback(pbt->data, pbt->thread_number);
+            if (callback(pbt->data, thread_number))
+                errors++;
             /* don't count if didn't finish in time */
-            if (!g_atomic_int_get(pbt->stop))
+            if (!g_atomic_int_get(pbt->stop)) {
                 count++;
+                slice = (bench_time_usec() - start) / pbt->slice_usec;
+                if (slice < BENCH_MAX_SLICES)
+                    __atomic_add_fetch(&pbt->slices[slice], 1, __ATOMIC_RELAXED);
+            }
         }
     } else {
         DEBUG("this is thread %p; callback is NULL and it should't be!",
               g_thread_self());
     }
 
-    g_free(pbt);
+    pbt->count = (double)count;
+    pbt->errors = errors;
+}
+
+/* each worker copies the input into memory of its node before the timed
+ * job, the shared one stays in use if it cannot */
+static void benchmark_crunch_local_dispatcher(gpointer data, gint thread_number)
+{
+    ParallelBenchTask *pbt = (ParallelBenchTask *)data + thread_number;
+    gpointer local = bench_local_copy(pbt->data, pbt->local_size, &pbt->local_mapped,
+                                      &pbt->local_kind);
 
-    *(double *)return_value = (double)count;
-    return return_value;
+    if (local)
+        pbt->data = local;
 }
 
-bench_value benchmark_crunch_for(float seconds,
-                                 gint n_threads,
-                                 gpointer callback,
-                                 gpointer callback_data)
+/* throughput series relative to the run average, sustained/burst ratio
+ * and per thread imbalance */
+static void benchmark_crunch_for_slices(bench_value *r,
+                                        const ParallelBenchTask *tasks,
+                                        double slice_time)
 {
-    int cpu_procs, cpu_cores, cpu_threads, cpu_nodes;
+    double total[BENCH_MAX_SLICES] = {0}, mean = 0, burst = 0, sustained = 0;
+    double tmin = tasks[0].count, tmax = tasks[0].count;
+    int i, t, n, n_burst;
+
+    n = MIN((int)(r->elapsed_time / slice_time), BENCH_MAX_SLICES);
+    for (t = 0; t < r->threads_used; t++) {
+        for (i = 0; i < n; i++)
+            total[i] += tasks[t].slices[i];
+        tmin = MIN(tmin, tasks[t].count);
+        tmax = MAX(tmax, tasks[t].count);
+    }
+    if (r->threads_used > 1 && tmax > 0)
+        r->imbalance = (tmax - tmin) / tmax;
+
+    if (n < 4)
+        return;
+    for (i = 0; i < n; i++)
+        mean += total[i];
+    mean /= n;
+    if (mean <= 0)
+        return;
+
+    r->slices = n;
+    r->slice_time = slice_time;
+    for (i = 0; i < n; i++)
+        r->slice[i] = total[i] / mean;
+
+    /* burst: first second, sustained: second half of the run */
+    n_burst = CLAMP((int)(1.0 / slice_time), 1, n / 2);
+    for (i = 0; i < n_burst; i++)
+        burst += r->slice[i];
+    for (i = n / 2; i < n; i++)
+        sustained += r->slice[i];
+    burst /= n_burst;
+    sustained /= n - n / 2;
+    if (burst > 0)
+        r->sustained_ratio = sustained / burst;
+}
+
+/* --bench-budget: seconds one crunch run of the current benchmark may take,
+ * 0 for no limit; set by run_benchmark()/run_benchmark_batch() */
+static double bench_run_budget = 0;
+
+double benchmark_run_budget(void)
+{
+    return bench_run_budget;
+}
+
+/* --bench-precision: longest run, BENCH_MAX_STRETCH times nominal unless
+ * the budget is shorter, never less than BENCH_MIN_SLICES slices */
+static double benchmark_crunch_max_time(float seconds)
+{
+    double max_seconds = BENCH_MAX_STRETCH * seconds;
+
+    if (bench_run_budget > 0)
+        max_seconds = MIN(max_seconds, bench_run_budget);
+    return MAX(max_seconds, BENCH_MIN_SLICES * BENCH_SLICE_TIME);
+}
+
+/* --bench-precision: wait slice by slice until the 95% CI of the mean
+ * completions per slice is within the target, or max_seconds; the slice
+ * being filled is left out. Returns the relative CI reached */
+static double benchmark_crunch_converge(const ParallelBenchTask *tasks, gint n_threads,
+                                        double slice_time, double max_seconds)
+{
+    double total[BENCH_MAX_SLICES], rel = -1, target = params.bench_precision / 100;
+    gint64 start = bench_time_usec(), slice_usec = slice_time * 1000000, now;
+    int done, max_slices = MIN((int)(max_seconds / slice_time), BENCH_MAX_SLICES), i, t;
+
+    for (;;) {
+        now = bench_time_usec() - start;
+        g_usleep(slice_usec - now % slice_usec + 1000);
+        done = (bench_time_usec() - start) / slice_usec - 1;
+        if (done < 2)
+            continue;
+        for (i = 0; i < done && i < max_slices; i++) {
+            total[i] = 0;
+            for (t = 0; t < n_threads; t++)
+                total[i] += __atomic_load_n(&tasks[t].slices[i], __ATOMIC_RELAXED);
+        }
+        rel = bench_rel_ci95(total, i);
+        if (done >= max_slices)
+            break;
+        if (done >= BENCH_MIN_SLICES && rel >= 0 && rel <= target)
+            break;
+    }
+    DEBUG("converged to %.2f%% in %d slices", 100 * rel, done);
+    return rel;
+}
+
+static bench_value benchmark_crunch_for_run(float seconds,
+                                            gint n_threads,
+                                            gpointer callback,
+                                            gpointer callback_data,
+                                            gsize local_size)
+{
+    int cpu_cores, cpu_threads;
     gint thread_number, stop = 0;
-    GSList *threads = NULL, *t;
+    ParallelBenchTask *tasks;
     GTimer *timer = NULL;
+    bench_counters counts;
     bench_value ret = EMPTY_BENCH_VALUE;
+    double max_seconds = (params.bench_precision > 0) ? benchmark_crunch_max_time(seconds) : seconds;
+    double slice_time = MAX(BENCH_SLICE_TIME, max_seconds / BENCH_MAX_SLICES), precision = 0;
 
     timer = g_timer_new();
 
-    cpu_procs_cores_threads_nodes(&cpu_procs, &cpu_cores, &cpu_threads, &cpu_nodes);
+    bench_workers_cores_threads(&cpu_cores, &cpu_threads);
     if (n_threads > 0)
         ret.threads_used = n_threads;
     else if (n_threads < 0)
@@ -148,83 +713,185 @@ bench_value benchmark_crunch_for(float seconds,
     else
         ret.threads_used = cpu_threads;
 
-    g_timer_start(timer);
+    tasks = g_new0(ParallelBenchTask, ret.threads_used);
     for (thread_number = 0; thread_number < ret.threads_used; thread_number++) {
-        ParallelBenchTask *pbt = g_new0(ParallelBenchTask, 1);
-        GThread *thread;
-
-        DEBUG("launching thread %d", thread_number);
-
-        pbt->thread_number = thread_number;
-        pbt->data = callback_data;
-        pbt->callback = callback;
-        pbt->stop = &stop;
-
-#if GLIB_CHECK_VERSION(2,32,0)
-        thread = g_thread_new("dispatcher", (GThreadFunc)benchmark_crunch_for_dispatcher, pbt);
-#else
-        thread = g_thread_create((GThreadFunc)benchmark_crunch_for_dispatcher, pbt,TRUE,NULL);
-#endif
-        threads = g_slist_prepend(threads, thread);
+        tasks[thread_number].data = callback_data;
+        tasks[thread_number].callback = callback;
+        tasks[thread_number].stop = &stop;
+        tasks[thread_number].slice_usec = slice_time * 1000000;
+        tasks[thread_number].local_size = local_size;
+    }
 
-        DEBUG("thread %d launched as context %p", thread_number, thread);
+    if (local_size > 0) {
+        DEBUG("copying %" G_GSIZE_FORMAT " bytes of input to each worker", local_size);
+        bench_workers_start(ret.threads_used, benchmark_crunch_local_dispatcher, tasks);
+        bench_workers_wait();
+        ret.local_input = BENCH_LOCAL_HUGETLB;
+        for (thread_number = 0; thread_number < ret.threads_used; thread_number++)
+            ret.local_input = MIN(ret.local_input, tasks[thread_number].local_kind);
     }
 
+    /* all workers are released together, start timing from there */
+    DEBUG("starting %d workers", ret.threads_used);
+    bench_workers_start(ret.threads_used, benchmark_crunch_for_dispatcher, tasks);
+    g_timer_start(timer);
+
     /* wait for time */
     // while ( g_timer_elapsed(timer, NULL) < seconds ) { }
-    g_usleep(seconds * 1000000);
+    if (params.bench_precision > 0)
+        precision = benchmark_crunch_converge(tasks, ret.threads_used, slice_time, max_seconds);
+    else
+        g_usleep(seconds * 1000000);
 
     /* signal all threads to stop */
     g_atomic_int_set(&stop, 1);
     g_timer_stop(timer);
 
-    ret.result = 0;
     DEBUG("waiting for all threads to finish");
-    for (t = threads; t; t = t->next) {
-        DEBUG("waiting for thread with context %p", t->data);
-        gpointer *rv = g_thread_join((GThread *)t->data);
-        ret.result += *(double *)rv;
-        g_free(rv);
+    bench_workers_wait();
+
+    ret.result = 0;
+    for (thread_number = 0; thread_number < ret.threads_used; thread_number++) {
+        ret.result += tasks[thread_number].count;
+        ret.errors += tasks[thread_number].errors;
+        bench_local_free(tasks[thread_number].data, tasks[thread_number].local_mapped);
     }
 
     ret.elapsed_time = g_timer_elapsed(timer, NULL);
+    /* scores stay completions per nominal run, whatever the length */
+    if (params.bench_precision > 0 && ret.elapsed_time > 0) {
+        ret.result *= seconds / ret.elapsed_time;
+        ret.precision = (precision >= 0) ? precision : 1;
+    }
+    benchmark_crunch_for_slices(&ret, tasks, slice_time);
+    if (bench_workers_counters(&counts))
+        bench_counters_result(&ret, &counts);
 
-    g_slist_free(threads);
+    g_free(tasks);
     g_timer_destroy(timer);
 
     return ret;
 }
 
-static gpointer benchmark_parallel_for_dispatcher(gpointer data)
+/* scaling stops paying once another thread adds less than half of what the
+ * first thread did; the knee is the last thread count before that */
+void benchmark_sweep_knee(bench_value *r)
+{
+    double gain;
+    int i;
+
+    r->sweep_knee = r->sweep_threads[r->sweep_steps - 1];
+    for (i = 1; i < r->sweep_steps; i++) {
+        gain = (r->sweep_rate[i] - r->sweep_rate[i - 1]) /
+               (r->sweep_threads[i] - r->sweep_threads[i - 1]);
+        if (gain < 0.5 * r->sweep_rate[0]) {
+            r->sweep_knee = r->sweep_threads[i - 1];
+            break;
+        }
+    }
+}
+
+/* --bench-sweep: the same run at 1, 2, 4 ... threads, the last step (the
+ * requested threads) is the result */
+static bench_value benchmark_crunch_sweep(float seconds,
+                                          gint n_threads,
+                                          gpointer callback,
+                                          gpointer callback_data,
+                                          gsize local_size)
+{
+    int cpu_cores, cpu_threads;
+    int threads, max_threads, steps = 0, errors = 0;
+    int sweep_threads[BENCH_MAX_SWEEP];
+    double sweep_rate[BENCH_MAX_SWEEP];
+    bench_value r = EMPTY_BENCH_VALUE;
+    double budget = bench_run_budget;
+
+    bench_workers_cores_threads(&cpu_cores, &cpu_threads);
+    max_threads = (n_threads < 0) ? cpu_cores : cpu_threads;
+    /* a benchmark with a fixed thread count is swept up to that count */
+    if (n_threads > 0)
+        max_threads = MIN(max_threads, n_threads);
+
+    /* the budget of the run is shared by the steps */
+    for (threads = 1; threads < max_threads; threads *= 2)
+        steps++;
+    if (budget > 0)
+        bench_run_budget = budget / MIN(steps + 1, BENCH_MAX_SWEEP);
+    steps = 0;
+
+    for (threads = 1; steps < BENCH_MAX_SWEEP; threads = MIN(threads * 2, max_threads)) {
+        DEBUG("sweep: %d of %d threads", threads, max_threads);
+        r = benchmark_crunch_for_run(seconds, threads, callback, callback_data, local_size);
+        errors += r.errors;
+        if (r.result <= 0 || r.elapsed_time <= 0)
+            break;
+        sweep_threads[steps] = threads;
+        /* adaptive runs are already scaled to the nominal length */
+        sweep_rate[steps] = r.result / (params.bench_precision > 0 ? seconds : r.elapsed_time);
+        steps++;
+        if (threads >= max_threads)
+            break;
+    }
+    bench_run_budget = budget;
+    r.errors = errors;
+    if (r.result <= 0 || r.elapsed_time <= 0)
+        return r;
+
+    r.sweep_steps = steps;
+    memcpy(r.sweep_threads, sweep_threads, steps * sizeof(int));
+    memcpy(r.sweep_rate, sweep_rate, steps * sizeof(double));
+    benchmark_sweep_knee(&r);
+    return r;
+}
+
+bench_value benchmark_crunch_for(float seconds,
+                                 gint n_threads,
+                                 gpointer callback,
+                                 gpointer callback_data)
+{
+    if (params.bench_sweep && n_threads != 1)
+        return benchmark_crunch_sweep(seconds, n_threads, callback, callback_data, 0);
+    return benchmark_crunch_for_run(seconds, n_threads, callback, callback_data, 0);
+}
+
+/* first touch by the pinned workers keeps the input on their NUMA node, so
+ * on several sockets the score is not the interconnect's */
+bench_value benchmark_crunch_for_local(float seconds,
+                                       gint n_threads,
+                                       gpointer callback,
+                                       gconstpointer data,
+                                       gsize size)
+{
+    if (params.bench_sweep && n_threads != 1)
+        return benchmark_crunch_sweep(seconds, n_threads, callback, (gpointer)data, size);
+    return benchmark_crunch_for_run(seconds, n_threads, callback, (gpointer)data, size);
+}
+
+static void benchmark_parallel_for_dispatcher(gpointer data, gint thread_number)
 {
-    ParallelBenchTask *pbt = (ParallelBenchTask *)data;
+    ParallelBenchTask *pbt = (ParallelBenchTask *)data + thread_number;
     gpointer (*callback)(unsigned int start, unsigned int end, void *data,
                          gint thread_number);
-    gpointer return_value = NULL;
 
     if ((callback = pbt->callback)) {
         DEBUG("this is thread %p; items %d -> %d, data %p", g_thread_self(),
               pbt->start, pbt->end, pbt->data);
-        return_value =
-            callback(pbt->start, pbt->end, pbt->data, pbt->thread_number);
+        pbt->return_value =
+            callback(pbt->start, pbt->end, pbt->data, thread_number);
         DEBUG("this is thread %p; return value is %p", g_thread_self(),
-              return_value);
+              pbt->return_value);
     } else {
         DEBUG("this is thread %p; callback is NULL and it should't be!",
               g_thread_self());
     }
-
-    g_free(pbt);
-
-    return return_value;
 }
 
 /* one call for each thread to be used */
 bench_value
 benchmark_parallel(gint n_threads, gpointer callback, gpointer callback_data)
 {
-    int cpu_procs, cpu_cores, cpu_threads, cpu_nodes;
-    cpu_procs_cores_threads_nodes(&cpu_procs, &cpu_cores, &cpu_threads, &cpu_nodes);
+    int cpu_cores, cpu_threads;
+    bench_workers_cores_threads(&cpu_cores, &cpu_threads);
 
     if (n_threads == 0)
         n_threads = cpu_threads;
@@ -246,16 +913,17 @@ bench_value benchmark_parallel_for(gint n_threads,
                                    gpointer callback,
                                    gpointer callback_data)
 {
-    int cpu_procs, cpu_cores, cpu_threads, cpu_nodes;
-    guint iter_per_thread=1, iter, thread_number = 0;
-    GSList *threads = NULL, *t;
+    int cpu_cores, cpu_threads;
+    guint iter_per_thread=1, iter, thread_number = 0, t;
+    ParallelBenchTask *tasks;
     GTimer *timer;
+    bench_counters counts;
 
     bench_value ret = EMPTY_BENCH_VALUE;
 
     timer = g_timer_new();
 
-    cpu_procs_cores_threads_nodes(&cpu_procs, &cpu_cores, &cpu_threads, &cpu_nodes);
+    bench_workers_cores_threads(&cpu_cores, &cpu_threads);
 
     if (n_threads > 0)
         ret.threads_used = n_threads;
@@ -278,10 +946,9 @@ bench_value benchmark_parallel_for(gint n_threads,
     /*DEBUG("Using %d threads across %d logical processors; processing %d elements (%d per thread)",
       ret.threads_used, cpu_threads, (end - start), iter_per_thread);*/
 
-    g_timer_start(timer);
+    tasks = g_new0(ParallelBenchTask, MAX(ret.threads_used, 1));
     for (iter = start; iter < end;) {
-        ParallelBenchTask *pbt = g_new0(ParallelBenchTask, 1);
-        GThread *thread;
+        ParallelBenchTask *pbt = &tasks[thread_number++];
 
         guint ts = iter, te = iter + iter_per_thread;
         /* add the remainder of items/iter_per_thread to the last thread */
@@ -289,29 +956,26 @@ bench_value benchmark_parallel_for(gint n_threads,
             te = end;
         iter = te;
 
-        DEBUG("launching thread %d", 1 + thread_number);
-
-        pbt->thread_number = thread_number++;
         pbt->start = ts;
         pbt->end = te - 1;
         pbt->data = callback_data;
         pbt->callback = callback;
+    }
 
-#if GLIB_CHECK_VERSION(2,32,0)
-        thread = g_thread_new("dispatcher", (GThreadFunc)benchmark_parallel_for_dispatcher, pbt);
-#else
-        thread = g_thread_create((GThreadFunc)benchmark_parallel_for_dispatcher, pbt,TRUE,NULL);
-#endif
+    DEBUG("starting %d workers", thread_number);
+    bench_workers_start(thread_number, benchmark_parallel_for_dispatcher, tasks);
+    g_timer_start(timer);
 
-        threads = g_slist_prepend(threads, thread);
+    DEBUG("waiting for all threads to finish");
+    bench_workers_wait();
 
-        DEBUG("thread %d launched as context %p", thread_number, thread);
-    }
+    g_timer_stop(timer);
+    ret.elapsed_time = g_timer_elapsed(timer, NULL);
+    if (bench_workers_counters(&counts))
+        bench_counters_result(&ret, &counts);
 
-    DEBUG("waiting for all threads to finish");
-    for (t = threads; t; t = t->next) {
-        DEBUG("waiting for thread with context %p", t->data);
-        gpointer *rv = g_thread_join((GThread *)t->data);
+    for (t = 0; t < thread_number; t++) {
+        gpointer rv = tasks[t].return_value;
         if (rv) {
             if (ret.result == -1.0)
                 ret.result = 0;
@@ -320,10 +984,7 @@ bench_value benchmark_parallel_for(gint n_threads,
         g_free(rv);
     }
 
-    g_timer_stop(timer);
-    ret.elapsed_time = g_timer_elapsed(timer, NULL);
-
-    g_slist_free(threads);
+    g_free(tasks);
     g_timer_destroy(timer);
 
     DEBUG("finishing; all threads took %f seconds to finish", ret.elapsed_time);
@@ -343,10 +1004,31 @@ gchar *hi_get_field(gchar *field)
     return g_strdup(info ? info : field);
 }
 
-static void br_mi_add(char **results_list, bench_result *b, gboolean select)
+/* "±1.23% (n=5)" for results with several trials */
+static gchar *br_spread_str(bench_result *b)
+{
+    if (b->bvalue.trials < 2 || b->bvalue.result <= 0.0)
+        return g_strdup("");
+    return g_strdup_printf("\u00b1%.2f%% (n=%d)",
+                           100 * b->bvalue.ci95 / b->bvalue.result,
+                           b->bvalue.trials);
+}
+
+static void br_mi_add(char **results_list, bench_result *b, gboolean select,
+                      gboolean show_spread)
 {
     static unsigned int ri = 0; /* to ensure key is unique */
-    gchar *rkey, *lbl, *elbl, *this_marker;
+    gchar *rkey, *lbl, *elbl, *this_marker, *spread;
+    /* '!': reports always include the details, e.g. the NUMA matrix */
+    const gchar *flags = !select ? "" :
+        (b->bvalue.numa_nodes > 0 || b->bvalue.c2c_units > 0 ||
+         b->bvalue.storage_tests > 0 || b->bvalue.net_tests > 0 ||
+         b->bvalue.hash_paths > 0 || b->bvalue.gemm > 0 ||
+         b->bvalue.sync_tests > 0 || b->bvalue.alloc_tests > 0 ||
+         b->bvalue.power_w > 0 || b->bvalue.telemetry > 0 ||
+         b->bvalue.isolated_cpus > 0 ? "*!" : "*");
+    /* old format, run on a busy machine or with failed checks */
+    gboolean problem = b->legacy || b->bvalue.noise > BENCH_NOISE_WARN || b->bvalue.errors > 0;
 
     if (select) {
         this_marker = format_with_ansi_color(_("This Machine"), "0;30;43",
@@ -360,29 +1042,36 @@ static void br_mi_add(char **results_list, bench_result *b, gboolean select)
     if(strstr(b->name,"GPU")){//GPU
         lbl = g_strdup_printf("%s%s%s%s", this_marker, select ? " " : "",
                           b->machine->gpu_name,
-                          b->legacy ? problem_marker() : "");
+                          problem ? problem_marker() : "");
     } else if(strstr(b->name,"Storage")){//Storage
         lbl = g_strdup_printf("%s%s%s%s", this_marker, select ? " " : "",
                           b->machine->storage,
-                          b->legacy ? problem_marker() : "");
+                          problem ? problem_marker() : "");
     } else {//CPU
         lbl = g_strdup_printf("%s%s%s%s", this_marker, select ? " " : "",
                           b->machine->cpu_name,
-                          b->legacy ? problem_marker() : "");
+                          problem ? problem_marker() : "");
     }
     elbl = key_label_escape(lbl);
-
-    if(strstr(b->name,"GPU")){//GPU
-         *results_list = h_strdup_cprintf("$@%s%s$%s=%.2f\n", *results_list,
-                                     select ? "*" : "", rkey, elbl,
-                                     b->bvalue.result);
-    } else if(strstr(b->name,"Storage")){//Storage
-        *results_list = h_strdup_cprintf("$@%s%s$%s=%.2f\n", *results_list,
-                                     select ? "*" : "", rkey, elbl,
+    spread = br_spread_str(b);
+
+    if(strstr(b->name,"GPU") || strstr(b->name,"Storage")){//GPU, Storage
+        if (show_spread)
+            *results_list = h_strdup_cprintf("$@%s%s$%s=%.2f|%s\n", *results_list,
+                                     flags, rkey, elbl,
+                                     b->bvalue.result, spread);
+        else
+            *results_list = h_strdup_cprintf("$@%s%s$%s=%.2f\n", *results_list,
+                                     flags, rkey, elbl,
                                      b->bvalue.result);
     } else {//CPU
-        *results_list = h_strdup_cprintf("$@%s%s$%s=%.2f|%s\n", *results_list,
-                                     select ? "*" : "", rkey, elbl,
+        if (show_spread)
+            *results_list = h_strdup_cprintf("$@%s%s$%s=%.2f|%s|%s\n", *results_list,
+                                     flags, rkey, elbl,
+                                     b->bvalue.result, b->machine->cpu_config, spread);
+        else
+            *results_list = h_strdup_cprintf("$@%s%s$%s=%.2f|%s\n", *results_list,
+                                     flags, rkey, elbl,
                                      b->bvalue.result, b->machine->cpu_config);
     }
 
@@ -391,6 +1080,7 @@ static void br_mi_add(char **results_list, bench_result *b, gboolean select)
     g_free(lbl);
     g_free(elbl);
     g_free(rkey);
+    g_free(spread);
     if (*this_marker)
         g_free(this_marker);
 }
@@ -487,19 +1177,16 @@ struct bench_window {
     int min, max;
 };
 
-static struct bench_window get_bench_window(GSList *result_list,
-                                            const bench_result *this_machine)
+static struct bench_window get_bench_window(int len, int loc)
 {
     struct bench_window window = {};
     int size = params.max_bench_results;
-    int len = g_slist_length(result_list);
 
     if (size == 0)
         size = 1;
     else if (size < 0)
         size = len;
 
-    int loc = g_slist_index(result_list, this_machine); /* -1 if not found */
     if (loc >= 0) {
         window.min = loc - size / 2;
         window.max = window.min + size;
@@ -525,98 +1212,132 @@ static gboolean is_in_bench_window(const struct bench_window *window, int i)
     return i >= window->min && i < window->max;
 }
 
+#include "benchmark/bench_index.c"
+
 static gchar *benchmark_include_results_internal(bench_value this_machine_value,
                                                  const gchar *benchmark,
                                                  ShellOrderType order_type)
 {
     bench_result *this_machine;
+    bench_index *idx;
+    struct bench_window window;
     GSList *result_list=NULL, *li;
     gchar *results = g_strdup("");
     gchar *output;
     gchar *path;
+    gchar *spread_col = NULL;
+    gboolean show_spread = FALSE;
     gint i;
 
-    path = find_benchmark_conf();
-    if (path) {
-        result_list = benchmark_include_results_json(
-            path, this_machine_value, benchmark);
-    }
-
     /* this result */
     if (this_machine_value.result > 0.0) {
         this_machine = bench_result_this_machine(benchmark, this_machine_value);
-        result_list = g_slist_prepend(result_list, this_machine);
     } else {
         this_machine = NULL;
     }
 
-    /* sort */
-    result_list = g_slist_sort(result_list, bench_result_sort);
-    if (order_type == SHELL_ORDER_DESCENDING)
-        result_list = g_slist_reverse(result_list);
+    path = find_benchmark_conf();
+    if (path && (idx = bench_index_open(path))) {
+        /* only the shown window, already sorted */
+        result_list = bench_index_results(idx, benchmark, this_machine, order_type);
+        window.min = 0;
+        window.max = g_slist_length(result_list);
+    } else {
+        if (path) {
+            result_list = benchmark_include_results_json(
+                path, this_machine_value, benchmark);
+        }
+        if (this_machine)
+            result_list = g_slist_prepend(result_list, this_machine);
+
+        /* sort */
+        result_list = g_slist_sort(result_list, bench_result_sort);
+        if (order_type == SHELL_ORDER_DESCENDING)
+            result_list = g_slist_reverse(result_list);
+
+        window = get_bench_window(g_slist_length(result_list),
+                                  g_slist_index(result_list, this_machine));
+    }
 
     /* prepare for shell */
     moreinfo_del_with_prefix("BENCH");
 
-    const struct bench_window window = get_bench_window(result_list, this_machine);
+    /* spread column only when a shown result has several trials */
+    for (i = 0, li = result_list; li; li = g_slist_next(li), i++) {
+        bench_result *br = li->data;
+        if (is_in_bench_window(&window, i) && br->bvalue.trials > 1) show_spread = TRUE;
+    }
 
     for (i = 0, li = result_list; li; li = g_slist_next(li), i++) {
         bench_result *br = li->data;
-        if (is_in_bench_window(&window, i)) br_mi_add(&results, br, br == this_machine);
+        if (is_in_bench_window(&window, i)) br_mi_add(&results, br, br == this_machine, show_spread);
         bench_result_free(br); /* no longer needed */
     }
     g_slist_free(result_list);
     if(strstr(benchmark,"GPU")){//GPU
+        if (show_spread)
+            spread_col = g_strdup_printf("ColumnTitle$Extra1=%s\n", _("Spread"));
         output = shell_param_insert_no_sort(
                       g_strdup_printf("[$ShellParam$]\n"
                           "Zebra=1\n"
                           "OrderType=%d\n"
                           "ViewType=4\n"
+                          "%s"                         /* Spread */
                           "ColumnTitle$Progress=%s\n"  /* Results */
                           "ColumnTitle$TextValue=%s\n" /* GPU */
                           "ShowColumnHeaders=true\n"
                           "[%s]\n%s",
                              order_type,
+                             spread_col ? spread_col : "",
                              _("Results"),
                              _("GPU"),
                              benchmark,
                              results),
-                      (const gchar *[]){"Progress", "TextValue", NULL});
+                      (const gchar *[]){"Extra1", "Progress", "TextValue", NULL});
     }else if(strstr(benchmark,"Storage")){//Storage
+        if (show_spread)
+            spread_col = g_strdup_printf("ColumnTitle$Extra1=%s\n", _("Spread"));
         output = shell_param_insert_no_sort(
                       g_strdup_printf("[$ShellParam$]\n"
                           "Zebra=1\n"
                           "OrderType=%d\n"
                           "ViewType=4\n"
+                          "%s"                         /* Spread */
                           "ColumnTitle$Progress=%s\n"  /* Results */
                           "ColumnTitle$TextValue=%s\n" /* GPU */
                           "ShowColumnHeaders=true\n"
                           "[%s]\n%s",
                              order_type,
+                             spread_col ? spread_col : "",
                              _("Results"),
                              _("Storage"),
                              benchmark,
                              results),
-                      (const gchar *[]){"Progress", "TextValue", NULL});
+                      (const gchar *[]){"Extra1", "Progress", "TextValue", NULL});
     } else {//CPU
+        if (show_spread)
+            spread_col = g_strdup_printf("ColumnTitle$Extra2=%s\n", _("Spread"));
         output = shell_param_insert_no_sort(
                       g_strdup_printf("[$ShellParam$]\n"
                           "Zebra=1\n"
                           "OrderType=%d\n"
                           "ViewType=4\n"
                           "ColumnTitle$Extra1=%s\n"    /* CPU Clock */
+                          "%s"                         /* Spread */
                           "ColumnTitle$Progress=%s\n"  /* Results */
                           "ColumnTitle$TextValue=%s\n" /* CPU */
                           "ShowColumnHeaders=true\n"
                           "[%s]\n%s",
                              order_type,
                              _("CPU Config"),
+                             spread_col ? spread_col : "",
                              _("Results"),
                              _("CPU"),
                              benchmark,
                              results),
-                      (const gchar *[]){"Extra1", "Progress", "TextValue", NULL});
+                      (const gchar *[]){"Extra1", "Extra2", "Progress", "TextValue", NULL});
     }
+    g_free(spread_col);
     g_free(path);
     g_free(results);
 
@@ -641,6 +1362,7 @@ typedef struct _BenchmarkDialog BenchmarkDialog;
 struct _BenchmarkDialog {
     GtkWidget *dialog;
     bench_value r;
+    int btimer_done; /* batch: expected seconds of started benchmarks */
 };
 
 static gboolean
@@ -674,40 +1396,13 @@ static gboolean benchmark_update(gpointer user_data){
   return TRUE;
 }
 
-static void do_benchmark(void (*benchmark_function)(void), int entry)
+/* modal dialog shown while a benchmark child runs, Stop aborts */
+static GtkWidget *benchmark_dialog_new(const gchar *name, const gchar *icon)
 {
-    int old_priority = 0;
-
-    if (params.skip_benchmarks)
-        return;
-
-    if (params.gui_running && !params.run_benchmark) {
-        gchar *argv[] = {params.argv0, "-b",entries[entry].name,"-n",params.darkmode?"1":"0",NULL};
-        GPid bench_pid;
-        gint bench_stdout;
-        GtkWidget *bench_dialog = NULL;
-        GtkWidget *bench_image;
-        BenchmarkDialog *benchmark_dialog = NULL;
-        GSpawnFlags spawn_flags = G_SPAWN_STDERR_TO_DEV_NULL;
-	gchar *bench_status;
-        GtkWidget *content_area, *box, *label;
-        bench_value r = EMPTY_BENCH_VALUE;
-        GIOChannel *channel=NULL;
-        guint watch_id;
-	gchar *title;
-        gboolean done=FALSE;
-	guint btimer_id=0;
-
-        bench_results[entry] = r;
+    GtkWidget *bench_dialog, *bench_image, *content_area, *box, *label;
+    gchar *title;
 
-	bench_status = g_strdup_printf(_("Benchmarking: <b>%s</b>."), _(entries[entry].name));
-	btotaltimer=entries_btimer[entry];
-	btimer=entries_btimer[entry];
-	benchmark_update(NULL);
-        shell_status_update(bench_status);
-	g_free(bench_status);
-
-	title=g_strdup_printf(_("Benchmarking: %s"),_(entries[entry].name));
+	title=g_strdup_printf(_("Benchmarking: %s"),_(name));
 	bench_dialog = gtk_dialog_new_with_buttons (title,
                                       GTK_WINDOW(shell_get_main_shell()->transient_dialog),
                                       GTK_DIALOG_DESTROY_WITH_PARENT | GTK_DIALOG_MODAL,
@@ -717,7 +1412,7 @@ static void do_benchmark(void (*benchmark_function)(void), int entry)
 
 	content_area = gtk_dialog_get_content_area (GTK_DIALOG(bench_dialog));
 
-        bench_image = icon_cache_get_image_at_size(entries[entry].icon, 64, 64);
+        bench_image = icon_cache_get_image_at_size(icon, 64, 64);
 
 #if GTK_CHECK_VERSION(3,0,0)
 	box = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 1);
@@ -739,17 +1434,302 @@ static void do_benchmark(void (*benchmark_function)(void), int entry)
 	gtk_window_set_deletable(GTK_WINDOW(bench_dialog), FALSE);
 	gtk_widget_show_all (bench_dialog);
 
+    return bench_dialog;
+}
+
+static gint benchmark_entry_index(const gchar *name)
+{
+    gint i;
+
+    for (i = 0; entries[i].name; i++)
+        if (SEQ(entries[i].name, name))
+            return i;
+    return -1;
+}
+
+/* lines of a --bench-batch child: "@progress\tN\tCOUNT\tNAME",
+ * "@result\tNAME\tVALUE", "@error\tNAME" and "@done" */
+static gboolean
+do_benchmark_batch_handler(GIOChannel *source, GIOCondition condition, gpointer data)
+{
+    BenchmarkDialog *bench_dialog = (BenchmarkDialog *)data;
+    GIOStatus status;
+    gchar *line = NULL, **f, *bench_status;
+    gint i;
+
+    status = g_io_channel_read_line(source, &line, NULL, NULL, NULL);
+    if (status == G_IO_STATUS_AGAIN)
+        return TRUE;
+    if (status != G_IO_STATUS_NORMAL) {
+        DEBUG("benchmark batch ended before @done");
+        gtk_dialog_response(GTK_DIALOG(bench_dialog->dialog), GTK_RESPONSE_NONE);
+        return FALSE;
+    }
+
+    g_strchomp(line);
+    f = g_strsplit(line, "\t", 4);
+    g_free(line);
+
+    if (SEQ(f[0], "@progress") && g_strv_length(f) == 4 &&
+        (i = benchmark_entry_index(f[3])) >= 0) {
+        gchar *title = g_strdup_printf(_("Benchmarking: %s"), _(entries[i].name));
+        gtk_window_set_title(GTK_WINDOW(bench_dialog->dialog), title);
+        g_free(title);
+
+        bench_status = g_strdup_printf(_("Benchmarking: <b>%s</b> (%s/%s)."),
+                                       _(entries[i].name), f[1], f[2]);
+        shell_status_update(bench_status);
+        g_free(bench_status);
+
+        /* progress of the whole batch */
+        btimer = btotaltimer - bench_dialog->btimer_done;
+        bench_dialog->btimer_done += entries_btimer[i] *
+            (params.bench_repeat > 1 ? params.bench_repeat + params.bench_warmup : 1) +
+            params.bench_gap;
+    } else if (SEQ(f[0], "@result") && g_strv_length(f) >= 3 &&
+               (i = benchmark_entry_index(f[1])) >= 0) {
+        bench_results[i] = bench_value_from_str(f[2]);
+    } else if (SEQ(f[0], "@error") && f[1]) {
+        DEBUG("benchmark batch: unknown benchmark %s", f[1]);
+    } else if (SEQ(f[0], "@done")) {
+        g_strfreev(f);
+        gtk_dialog_response(GTK_DIALOG(bench_dialog->dialog), GTK_RESPONSE_NONE);
+        return FALSE;
+    }
+
+    g_strfreev(f);
+    return TRUE;
+}
+
+/* GUI: option and value (NULL for a flag), value is freed with argv */
+static void benchmark_child_arg(GPtrArray *argv, const gchar *option, gchar *value)
+{
+    g_ptr_array_add(argv, g_strdup(option));
+    if (value)
+        g_ptr_array_add(argv, value);
+}
+
+/* GUI: the --bench-* options of this process for a benchmark child,
+ * ends argv */
+static void benchmark_child_options(GPtrArray *argv)
+{
+    gchar precision[G_ASCII_DTOSTR_BUF_SIZE];
+
+    benchmark_child_arg(argv, "--bench-repeat", g_strdup_printf("%d", params.bench_repeat));
+    benchmark_child_arg(argv, "--bench-warmup", g_strdup_printf("%d", params.bench_warmup));
+    benchmark_child_arg(argv, "--bench-precision",
+                        g_strdup(g_ascii_dtostr(precision, sizeof(precision), params.bench_precision)));
+    benchmark_child_arg(argv, "--bench-budget", g_strdup_printf("%d", params.bench_budget));
+    benchmark_child_arg(argv, "--bench-max-load", g_strdup_printf("%d", params.bench_max_load));
+    benchmark_child_arg(argv, "--bench-hugepages",
+                        g_strdup(params.bench_hugepages ? params.bench_hugepages : "off"));
+    if (params.bench_isolate)
+        benchmark_child_arg(argv, "--bench-isolate", g_strdup(params.bench_isolate));
+    if (params.bench_sweep)
+        benchmark_child_arg(argv, "--bench-sweep", NULL);
+    if (params.bench_classes)
+        benchmark_child_arg(argv, "--bench-classes", NULL);
+    if (params.bench_counters)
+        benchmark_child_arg(argv, "--bench-counters", NULL);
+    if (params.bench_storage)
+        benchmark_child_arg(argv, "--bench-storage", g_strdup(params.bench_storage));
+    if (params.bench_zerocopy)
+        benchmark_child_arg(argv, "--bench-zerocopy", NULL);
+    if (params.bench_nqueens_depth > 0)
+        benchmark_child_arg(argv, "--bench-nqueens-depth",
+                            g_strdup_printf("%d", params.bench_nqueens_depth));
+    g_ptr_array_add(argv, NULL);
+}
+
+/* GUI: run the benchmarks of a comma separated list in one child process,
+ * instead of one hardinfo2 -b per benchmark, results go to bench_results[] */
+static void do_benchmark_batch(const gchar *list)
+{
+    GPtrArray *argv;
+    gchar **names = g_strsplit(list, ",", 0);
+    GSpawnFlags spawn_flags = G_SPAWN_STDERR_TO_DEV_NULL;
+    BenchmarkDialog *benchmark_dialog;
+    GIOChannel *channel;
+    GPid bench_pid;
+    gint bench_stdout, i, first = -1;
+    guint watch_id, btimer_id;
+    gboolean spawned;
+
+    btotaltimer = 0;
+    for (i = 0; names[i]; i++) {
+        gint e = benchmark_entry_index(names[i]);
+        if (e < 0) continue;
+        if (first < 0) first = e;
+        bench_results[e] = (bench_value)EMPTY_BENCH_VALUE;
+        btotaltimer += entries_btimer[e] *
+            (params.bench_repeat > 1 ? params.bench_repeat + params.bench_warmup : 1) +
+            params.bench_gap;
+    }
+    g_strfreev(names);
+    if (first < 0)
+        return;
+    btimer = btotaltimer;
+    benchmark_update(NULL);
+
+    argv = g_ptr_array_new_with_free_func(g_free);
+    g_ptr_array_add(argv, g_strdup(params.argv0));
+    benchmark_child_arg(argv, "--bench-batch", NULL);
+    benchmark_child_arg(argv, "-b", g_strdup(list));
+    benchmark_child_arg(argv, "-n", g_strdup(params.darkmode ? "1" : "0"));
+    benchmark_child_arg(argv, "--bench-gap", g_strdup_printf("%d", params.bench_gap));
+    benchmark_child_options(argv);
+
+    if (!g_path_is_absolute(params.argv0)) {
+        spawn_flags |= G_SPAWN_SEARCH_PATH;
+    }
+    spawned = g_spawn_async_with_pipes(NULL, (gchar **)argv->pdata, NULL, spawn_flags, NULL, NULL,
+                                       &bench_pid, NULL, &bench_stdout, NULL, NULL);
+    g_ptr_array_free(argv, TRUE);
+    if (!spawned)
+        return;
+
+    benchmark_dialog = g_new0(BenchmarkDialog, 1);
+    benchmark_dialog->dialog = benchmark_dialog_new(entries[first].name, entries[first].icon);
+    btimer_id = g_timeout_add(1000, benchmark_update, NULL);
+
+    channel = g_io_channel_unix_new(bench_stdout);
+    watch_id = g_io_add_watch(channel, G_IO_IN | G_IO_HUP, do_benchmark_batch_handler, benchmark_dialog);
+
+    if (gtk_dialog_run(GTK_DIALOG(benchmark_dialog->dialog)) != GTK_RESPONSE_NONE) {
+        /* stopped */
+        g_source_remove(watch_id);
+        kill(bench_pid, SIGINT);
+        params.aborting_benchmarks = 1;
+    }
+
+    g_io_channel_unref(channel);
+    gtk_widget_destroy(benchmark_dialog->dialog);
+    g_free(benchmark_dialog);
+    g_source_remove(btimer_id);
+}
+
+/* --bench-repeat: warm-up runs, then the median of the trials is the result */
+static void do_benchmark_repeat(void (*benchmark_function)(void), int entry)
+{
+    bench_value r = EMPTY_BENCH_VALUE;
+    double trial[BENCH_MAX_TRIALS], elapsed = 0;
+    int i, trials = MIN(params.bench_repeat, BENCH_MAX_TRIALS);
+    bench_energy *energy;
+    bench_telemetry *telemetry;
+
+    for (i = 0; i < params.bench_warmup; i++) {
+        DEBUG("warm-up run %d", i + 1);
+        benchmark_function();
+    }
+
+    energy = bench_energy_start();
+    telemetry = bench_telemetry_start();
+    for (i = 0; i < trials; i++) {
+        DEBUG("trial %d of %d", i + 1, trials);
+        bench_results[entry] = r;
+        benchmark_function();
+        if (bench_results[entry].result <= 0.0) {
+            bench_energy_stop(energy, &r); /* frees, r is dropped */
+            bench_telemetry_stop(telemetry, &r);
+            return; /* failed, keep as is */
+        }
+        trial[i] = bench_results[entry].result;
+        elapsed += bench_results[entry].elapsed_time;
+    }
+
+    r = bench_results[entry];
+    r.trials = trials;
+    memcpy(r.trial, trial, trials * sizeof(double));
+    bench_value_stats(&r);
+    r.result = r.median;
+    r.elapsed_time = elapsed / trials;
+    bench_energy_stop(energy, &r);
+    bench_telemetry_stop(telemetry, &r);
+    bench_results[entry] = r;
+}
+
+/* --bench-classes: run again pinned to each core class of a hybrid cpu;
+ * only benchmarks that used the worker pool since jobs can be pinned */
+static void do_benchmark_classes(void (*benchmark_function)(void), int entry,
+                                 guint jobs)
+{
+    bench_value r = bench_results[entry];
+    int c, n;
+
+    if (r.result <= 0.0 || bench_workers_jobs() == jobs)
+        return;
+    if ((n = bench_core_classes()) < 2)
+        return;
+
+    for (c = 0; c < n; c++) {
+        DEBUG("core class %s", bench_core_class_name(c));
+        bench_workers_set_class(c);
+        bench_results[entry] = (bench_value)EMPTY_BENCH_VALUE;
+        benchmark_function();
+        g_strlcpy(r.class_name[c], bench_core_class_name(c), sizeof(r.class_name[c]));
+        r.class_result[c] = bench_results[entry].result;
+    }
+    bench_workers_set_class(-1);
+
+    r.classes = n;
+    bench_results[entry] = r;
+}
+
+static void do_benchmark(void (*benchmark_function)(void), int entry)
+{
+    int old_priority = 0;
+    bench_isolate *isolate;
+    guint jobs;
+
+    if (params.skip_benchmarks)
+        return;
+
+    if (params.gui_running && !params.run_benchmark) {
+        GPtrArray *argv;
+        gboolean spawned;
+        GPid bench_pid;
+        gint bench_stdout;
+        GtkWidget *bench_dialog = NULL;
+        BenchmarkDialog *benchmark_dialog = NULL;
+        GSpawnFlags spawn_flags = G_SPAWN_STDERR_TO_DEV_NULL;
+	gchar *bench_status;
+        bench_value r = EMPTY_BENCH_VALUE;
+        GIOChannel *channel=NULL;
+        guint watch_id;
+        gboolean done=FALSE;
+	guint btimer_id=0;
+
+        bench_results[entry] = r;
+
+	bench_status = g_strdup_printf(_("Benchmarking: <b>%s</b>."), _(entries[entry].name));
+	btotaltimer=entries_btimer[entry];
+	if(params.bench_repeat > 1) btotaltimer*=params.bench_repeat+params.bench_warmup;
+	btimer=btotaltimer;
+	benchmark_update(NULL);
+        shell_status_update(bench_status);
+	g_free(bench_status);
+
+	bench_dialog = benchmark_dialog_new(entries[entry].name, entries[entry].icon);
+
         benchmark_dialog = g_new0(BenchmarkDialog, 1);
         benchmark_dialog->dialog = bench_dialog;
         benchmark_dialog->r = r;
 
+        argv = g_ptr_array_new_with_free_func(g_free);
+        g_ptr_array_add(argv, g_strdup(params.argv0));
+        benchmark_child_arg(argv, "-b", g_strdup(entries[entry].name));
+        benchmark_child_arg(argv, "-n", g_strdup(params.darkmode ? "1" : "0"));
+        benchmark_child_options(argv);
+
         if (!g_path_is_absolute(params.argv0)) {
             spawn_flags |= G_SPAWN_SEARCH_PATH;
         }
 
-        if (g_spawn_async_with_pipes(NULL, argv, NULL, spawn_flags, NULL, NULL,
-                                     &bench_pid, NULL, &bench_stdout, NULL,
-                                     NULL)) {
+        spawned = g_spawn_async_with_pipes(NULL, (gchar **)argv->pdata, NULL, spawn_flags, NULL, NULL,
+                                           &bench_pid, NULL, &bench_stdout, NULL,
+                                           NULL);
+        g_ptr_array_free(argv, TRUE);
+        if (spawned) {
 	    btimer_id=g_timeout_add(1000,benchmark_update,NULL);
 
             channel = g_io_channel_unix_new(bench_stdout);
@@ -782,7 +1762,28 @@ static void do_benchmark(void (*benchmark_function)(void), int entry)
     }
 
     setpriority(PRIO_PROCESS, 0, -20);
-    benchmark_function();
+    isolate = bench_isolate_start();
+    if (bench_isolate_refused(isolate, &bench_results[entry])) {
+        bench_isolate_stop(isolate, &bench_results[entry]);
+        setpriority(PRIO_PROCESS, 0, old_priority);
+        return;
+    }
+    jobs = bench_workers_jobs();
+    if (params.bench_repeat > 1) {
+        do_benchmark_repeat(benchmark_function, entry);
+    } else {
+        bench_energy *energy = bench_energy_start();
+        bench_telemetry *telemetry = bench_telemetry_start();
+        benchmark_function();
+        bench_telemetry_stop(telemetry, &bench_results[entry]);
+        bench_energy_stop(energy, &bench_results[entry]);
+    }
+    /* ns per watt would grow as efficiency falls */
+    if (benchmark_lower_is_better(entry))
+        bench_results[entry].score_per_watt = -1;
+    bench_isolate_stop(isolate, &bench_results[entry]);
+    if (params.bench_classes)
+        do_benchmark_classes(benchmark_function, entry, jobs);
     setpriority(PRIO_PROCESS, 0, old_priority);
 }
 
@@ -813,6 +1814,22 @@ static gchar *get_benchmark_results(gsize *len)
     gchar *out;
     guint i;
 
+    /* missing results in one batch child, the scans below keep them */
+    if (params.gui_running && !params.run_benchmark && !params.skip_benchmarks) {
+        gchar *list = NULL;
+        for (i = 0; i < G_N_ELEMENTS(entries); i++) {
+            if (!entries[i].name || !entries[i].scan_callback)
+                continue;
+            if (entries[i].flags & MODULE_FLAG_HIDE)
+                continue;
+            if (bench_results[i].result <= 0.0)
+                list = appf(list, ",", "%s", entries[i].name);
+        }
+        if (list)
+            do_benchmark_batch(list);
+        g_free(list);
+    }
+
     for (i = 0; i < G_N_ELEMENTS(entries); i++) {
         if (!entries[i].name || !entries[i].scan_callback)
             continue;
@@ -880,6 +1897,237 @@ static gchar *get_benchmark_results(gsize *len)
         ADD_JSON_VALUE(double, "ElapsedTime", bench_results[i].elapsed_time);
         ADD_JSON_VALUE(int, "UsedThreads", bench_results[i].threads_used);
         ADD_JSON_VALUE(int, "BenchmarkVersion", bench_results[i].revision);
+        if (bench_results[i].trials > 1) {
+            int t;
+            ADD_JSON_VALUE(int, "Trials", bench_results[i].trials);
+            ADD_JSON_VALUE(double, "ResultMedian", bench_results[i].median);
+            ADD_JSON_VALUE(double, "ResultMin", bench_results[i].min);
+            ADD_JSON_VALUE(double, "ResultMax", bench_results[i].max);
+            ADD_JSON_VALUE(double, "ResultStdDev", bench_results[i].stddev);
+            ADD_JSON_VALUE(double, "ResultCI95", bench_results[i].ci95);
+            json_builder_set_member_name(builder, "TrialResults");
+            json_builder_begin_array(builder);
+            for (t = 0; t < bench_results[i].trials; t++)
+                json_builder_add_double_value(builder, bench_results[i].trial[t]);
+            json_builder_end_array(builder);
+        }
+        if (bench_results[i].imbalance > 0) {
+            ADD_JSON_VALUE(double, "ThreadImbalance", bench_results[i].imbalance);
+        }
+        if (bench_results[i].slices > 0) {
+            int t;
+            ADD_JSON_VALUE(double, "SliceTime", bench_results[i].slice_time);
+            if (bench_results[i].precision > 0)
+                ADD_JSON_VALUE(double, "RunPrecision", bench_results[i].precision);
+            ADD_JSON_VALUE(double, "SustainedRatio", bench_results[i].sustained_ratio);
+            json_builder_set_member_name(builder, "ThroughputSeries");
+            json_builder_begin_array(builder);
+            for (t = 0; t < bench_results[i].slices; t++)
+                json_builder_add_double_value(builder, bench_results[i].slice[t]);
+            json_builder_end_array(builder);
+        }
+        if (bench_results[i].sweep_steps > 0) {
+            int t;
+            ADD_JSON_VALUE(int, "ScalingKnee", bench_results[i].sweep_knee);
+            json_builder_set_member_name(builder, "SweepThreads");
+            json_builder_begin_array(builder);
+            for (t = 0; t < bench_results[i].sweep_steps; t++)
+                json_builder_add_int_value(builder, bench_results[i].sweep_threads[t]);
+            json_builder_end_array(builder);
+            json_builder_set_member_name(builder, "SweepThroughput");
+            json_builder_begin_array(builder);
+            for (t = 0; t < bench_results[i].sweep_steps; t++)
+                json_builder_add_double_value(builder, bench_results[i].sweep_rate[t]);
+            json_builder_end_array(builder);
+        }
+        if (bench_results[i].classes > 0) {
+            int t;
+            json_builder_set_member_name(builder, "CoreClassNames");
+            json_builder_begin_array(builder);
+            for (t = 0; t < bench_results[i].classes; t++)
+                json_builder_add_string_value(builder, bench_results[i].class_name[t]);
+            json_builder_end_array(builder);
+            json_builder_set_member_name(builder, "CoreClassResults");
+            json_builder_begin_array(builder);
+            for (t = 0; t < bench_results[i].classes; t++)
+                json_builder_add_double_value(builder, bench_results[i].class_result[t]);
+            json_builder_end_array(builder);
+        }
+        if (bench_results[i].counters > 0) {
+            ADD_JSON_VALUE(double, "CounterIPC", bench_results[i].ipc);
+            ADD_JSON_VALUE(double, "CounterMPKI", bench_results[i].mpki);
+            ADD_JSON_VALUE(double, "CounterCacheMissRate", bench_results[i].cache_miss_rate);
+            ADD_JSON_VALUE(double, "CounterBranchMissRate", bench_results[i].branch_miss_rate);
+            ADD_JSON_VALUE(double, "CounterStalledFrontend", bench_results[i].stalled_frontend);
+            ADD_JSON_VALUE(double, "CounterStalledBackend", bench_results[i].stalled_backend);
+        }
+        if (bench_results[i].power_w > 0) {
+            ADD_JSON_VALUE(double, "EnergyJoules", bench_results[i].energy_j);
+            ADD_JSON_VALUE(double, "PowerWatts", bench_results[i].power_w);
+            ADD_JSON_VALUE(double, "ScorePerWatt", bench_results[i].score_per_watt);
+            ADD_JSON_VALUE(string, "PowerSource", bench_results[i].power_source);
+        }
+        if (bench_results[i].isolated_cpus > 0) {
+            ADD_JSON_VALUE(int, "IsolatedCPUs", bench_results[i].isolated_cpus);
+            ADD_JSON_VALUE(double, "NoiseScore", bench_results[i].noise);
+            ADD_JSON_VALUE(double, "LoadAverage", bench_results[i].load_avg);
+            ADD_JSON_VALUE(int, "InvoluntaryCtxSwitches", bench_results[i].nivcsw);
+        }
+        if (bench_results[i].errors > 0) {
+            ADD_JSON_VALUE(int, "VerifyErrors", bench_results[i].errors);
+        }
+        if (bench_results[i].local_input > 0) {
+            ADD_JSON_VALUE(int, "LocalInput", bench_results[i].local_input);
+        }
+        if (bench_results[i].telemetry > 0) {
+            int t;
+            json_builder_set_member_name(builder, "FreqMHz");
+            json_builder_begin_array(builder);
+            for (t = 0; t < 3; t++)
+                json_builder_add_double_value(builder, bench_results[i].freq_mhz[t]);
+            json_builder_end_array(builder);
+            ADD_JSON_VALUE(double, "PeakTempC", bench_results[i].temp_peak);
+            ADD_JSON_VALUE(boolean, "Throttled", bench_results[i].throttled);
+        }
+        if (bench_results[i].latency_steps > 0) {
+            int t;
+            json_builder_set_member_name(builder, "LatencySeries");
+            json_builder_begin_array(builder);
+            for (t = 0; t < bench_results[i].latency_steps; t++)
+                json_builder_add_double_value(builder, bench_results[i].latency[t]);
+            json_builder_end_array(builder);
+            json_builder_set_member_name(builder, "CacheLevelsKiB");
+            json_builder_begin_array(builder);
+            for (t = 0; t < bench_results[i].cache_levels; t++)
+                json_builder_add_int_value(builder, bench_results[i].cache_level_kib[t]);
+            json_builder_end_array(builder);
+        }
+        if (bench_results[i].numa_nodes > 0) {
+            int t, n = bench_results[i].numa_nodes;
+            ADD_JSON_VALUE(int, "NumaMatrixNodes", n);
+            json_builder_set_member_name(builder, "NumaNodeIds");
+            json_builder_begin_array(builder);
+            for (t = 0; t < n; t++)
+                json_builder_add_int_value(builder, bench_results[i].numa_id[t]);
+            json_builder_end_array(builder);
+            json_builder_set_member_name(builder, "NumaLatency");
+            json_builder_begin_array(builder);
+            for (t = 0; t < n * n; t++)
+                json_builder_add_double_value(builder, bench_results[i].numa_latency[t / n][t % n]);
+            json_builder_end_array(builder);
+            json_builder_set_member_name(builder, "NumaBandwidth");
+            json_builder_begin_array(builder);
+            for (t = 0; t < n * n; t++)
+                json_builder_add_double_value(builder, bench_results[i].numa_bandwidth[t / n][t % n]);
+            json_builder_end_array(builder);
+        }
+        if (bench_results[i].storage_tests > 0) {
+            int t, n = bench_results[i].storage_tests;
+            json_builder_set_member_name(builder, "StorageIOPS");
+            json_builder_begin_array(builder);
+            for (t = 0; t < n; t++)
+                json_builder_add_double_value(builder, bench_results[i].storage_iops[t]);
+            json_builder_end_array(builder);
+            json_builder_set_member_name(builder, "StorageMBs");
+            json_builder_begin_array(builder);
+            for (t = 0; t < n; t++)
+                json_builder_add_double_value(builder, bench_results[i].storage_mbs[t]);
+            json_builder_end_array(builder);
+            json_builder_set_member_name(builder, "StorageLatency");
+            json_builder_begin_array(builder);
+            for (t = 0; t < 3 * n; t++)
+                json_builder_add_double_value(builder, bench_results[i].storage_lat[t / 3][t % 3]);
+            json_builder_end_array(builder);
+        }
+        if (bench_results[i].c2c_units > 0) {
+            int t, n = bench_results[i].c2c_units;
+            ADD_JSON_VALUE(double, "CoreToCoreSMT", bench_results[i].c2c_kind[BENCH_C2C_SMT]);
+            ADD_JSON_VALUE(double, "CoreToCoreCCX", bench_results[i].c2c_kind[BENCH_C2C_CCX]);
+            ADD_JSON_VALUE(double, "CoreToCoreCrossCCX", bench_results[i].c2c_kind[BENCH_C2C_CROSS_CCX]);
+            ADD_JSON_VALUE(double, "CoreToCoreCrossSocket", bench_results[i].c2c_kind[BENCH_C2C_SOCKET]);
+            json_builder_set_member_name(builder, "CoreToCoreCpus");
+            json_builder_begin_array(builder);
+            for (t = 0; t < n; t++)
+                json_builder_add_int_value(builder, bench_results[i].c2c_unit_cpu[t]);
+            json_builder_end_array(builder);
+            json_builder_set_member_name(builder, "CoreToCoreGroups");
+            json_builder_begin_array(builder);
+            for (t = 0; t < n; t++)
+                json_builder_add_int_value(builder, bench_results[i].c2c_unit_group[t]);
+            json_builder_end_array(builder);
+            json_builder_set_member_name(builder, "CoreToCoreSockets");
+            json_builder_begin_array(builder);
+            for (t = 0; t < n; t++)
+                json_builder_add_int_value(builder, bench_results[i].c2c_unit_socket[t]);
+            json_builder_end_array(builder);
+            json_builder_set_member_name(builder, "CoreToCoreLatency");
+            json_builder_begin_array(builder);
+            for (t = 0; t < n * n; t++)
+                json_builder_add_double_value(builder, bench_results[i].c2c_latency[t / n][t % n]);
+            json_builder_end_array(builder);
+        }
+        if (bench_results[i].net_tests > 0) {
+            int t, n = bench_results[i].net_tests;
+            json_builder_set_member_name(builder, "NetworkGbits");
+            json_builder_begin_array(builder);
+            for (t = 0; t < n; t++)
+                json_builder_add_double_value(builder, bench_results[i].net_gbits[t]);
+            json_builder_end_array(builder);
+            ADD_JSON_VALUE(int, "NetworkStreams", bench_results[i].net_streams);
+            ADD_JSON_VALUE(double, "NetworkUDPLoss", bench_results[i].net_udp_loss);
+            json_builder_set_member_name(builder, "NetworkLatency");
+            json_builder_begin_array(builder);
+            for (t = 0; t < 3 * BENCH_NET_RTTS; t++)
+                json_builder_add_double_value(builder, bench_results[i].net_rtt[t / 3][t % 3]);
+            json_builder_end_array(builder);
+        }
+        if (bench_results[i].hash_paths > 0) {
+            int t, n = bench_results[i].hash_paths;
+            json_builder_set_member_name(builder, "HashMBs");
+            json_builder_begin_array(builder);
+            for (t = 0; t < BENCH_HASHES * n; t++)
+                json_builder_add_double_value(builder, bench_results[i].hash_mbs[t / n][t % n]);
+            json_builder_end_array(builder);
+        }
+        if (bench_results[i].gemm > 0) {
+            int t;
+            json_builder_set_member_name(builder, "GemmGFLOPS");
+            json_builder_begin_array(builder);
+            for (t = 0; t < 2 * BENCH_GEMM_PRECISIONS; t++)
+                json_builder_add_double_value(builder, bench_results[i].gemm_gflops[t / 2][t % 2]);
+            json_builder_end_array(builder);
+            json_builder_set_member_name(builder, "GemmPeakGFLOPS");
+            json_builder_begin_array(builder);
+            for (t = 0; t < 2 * BENCH_GEMM_PRECISIONS; t++)
+                json_builder_add_double_value(builder, bench_results[i].gemm_peak[t / 2][t % 2]);
+            json_builder_end_array(builder);
+        }
+        if (bench_results[i].sync_tests > 0 && bench_results[i].sweep_steps > 0) {
+            int t, n = bench_results[i].sweep_steps;
+            json_builder_set_member_name(builder, "SyncMops");
+            json_builder_begin_array(builder);
+            for (t = 0; t < BENCH_SYNC_TESTS * n; t++)
+                json_builder_add_double_value(builder, bench_results[i].sync_mops[t / n][t % n]);
+            json_builder_end_array(builder);
+            json_builder_set_member_name(builder, "SyncFairness");
+            json_builder_begin_array(builder);
+            for (t = 0; t < BENCH_SYNC_TESTS * n; t++)
+                json_builder_add_double_value(builder, bench_results[i].sync_fair[t / n][t % n]);
+            json_builder_end_array(builder);
+        }
+        if (bench_results[i].alloc_tests > 0) {
+            int t;
+            json_builder_set_member_name(builder, "AllocMops");
+            json_builder_begin_array(builder);
+            for (t = 0; t < 2 * BENCH_ALLOC_TESTS; t++)
+                json_builder_add_double_value(builder, bench_results[i].alloc_mops[t / 2][t % 2]);
+            json_builder_end_array(builder);
+            json_builder_set_member_name(builder, "AllocRSSMiB");
+            json_builder_begin_array(builder);
+            for (t = 0; t < 2 * BENCH_ALLOC_TESTS; t++)
+                json_builder_add_double_value(builder, bench_results[i].alloc_rss[t / 2][t % 2]);
+            json_builder_end_array(builder);
+        }
         ADD_JSON_VALUE(string, "PowerState", this_machine->power_state);
         ADD_JSON_VALUE(string, "GPU", this_machine->gpu_name);
         ADD_JSON_VALUE(string, "Storage", this_machine->storage);
@@ -906,6 +2154,16 @@ static gchar *get_benchmark_results(gsize *len)
     return out;
 }
 
+/* --bench-budget: seconds for the next benchmark, split over its repeated
+ * runs; never 0 once set, that would be no limit */
+static void benchmark_set_budget(double seconds)
+{
+    int runs = (params.bench_repeat > 1) ? params.bench_repeat + params.bench_warmup : 1;
+
+    if (params.bench_budget > 0)
+        bench_run_budget = MAX(seconds, 0.001) / runs;
+}
+
 static gchar *run_benchmark(gchar *name)
 {
     int i;
@@ -914,6 +2172,7 @@ static gchar *run_benchmark(gchar *name)
             void (*scan_callback)(gboolean rescan);
 
             if ((scan_callback = entries[i].scan_callback)) {
+                benchmark_set_budget(params.bench_budget);
                 scan_callback(FALSE);
 
 #define CHK_RESULT_FORMAT(F)                                                   \
@@ -937,10 +2196,71 @@ static gchar *run_benchmark(gchar *name)
     return NULL;
 }
 
+/* --bench-batch: run a comma separated list of benchmarks, or "all", back to
+ * back in this process; progress and results are streamed as lines, see
+ * do_benchmark_batch_handler() */
+static gchar *run_benchmark_batch(gchar *list)
+{
+    GPtrArray *names = g_ptr_array_new_with_free_func(g_free);
+    void (*scan_callback)(gboolean rescan);
+    gchar **l;
+    guint i, n;
+    gint e;
+    gint64 start = bench_time_usec();
+
+    if (SEQ(list, "all")) {
+        for (i = 0; entries[i].name; i++)
+            if (entries[i].scan_callback && !(entries[i].flags & MODULE_FLAG_HIDE))
+                g_ptr_array_add(names, g_strdup(entries[i].name));
+    } else {
+        l = g_strsplit(list, ",", 0);
+        for (i = 0; l[i]; i++)
+            if (*g_strstrip(l[i]))
+                g_ptr_array_add(names, g_strdup(l[i]));
+        g_strfreev(l);
+    }
+
+    for (n = 0; n < names->len && !params.aborting_benchmarks; n++) {
+        const gchar *name = g_ptr_array_index(names, n);
+        gchar *result;
+
+        if ((e = benchmark_entry_index(name)) < 0 ||
+            !(scan_callback = entries[e].scan_callback)) {
+            g_print("@error\t%s\n", name);
+            continue;
+        }
+        if (n > 0 && params.bench_gap > 0)
+            g_usleep((gulong)params.bench_gap * G_USEC_PER_SEC);
+
+        g_print("@progress\t%u\t%u\t%s\n", n + 1, names->len, name);
+        fflush(stdout);
+
+        /* what is left of the budget, by the usual length of the rest */
+        if (params.bench_budget > 0) {
+            double weight = 0, left = params.bench_budget - (bench_time_usec() - start) / 1e6;
+            for (i = n; i < names->len; i++) {
+                gint k = benchmark_entry_index(g_ptr_array_index(names, i));
+                if (k >= 0) weight += entries_btimer[k];
+            }
+            benchmark_set_budget(weight > 0 ? left * entries_btimer[e] / weight : left);
+        }
+
+        scan_callback(FALSE);
+        result = bench_value_to_str(bench_results[e]);
+        g_print("@result\t%s\t%s\n", name, result);
+        fflush(stdout);
+        g_free(result);
+    }
+
+    g_ptr_array_free(names, TRUE);
+    return g_strdup("@done");
+}
+
 const ShellModuleMethod *hi_exported_methods(void)
 {
     static const ShellModuleMethod m[] = {
         {"runBenchmark", run_benchmark},
+        {"runBenchmarkBatch", run_benchmark_batch},
         {NULL},
     };
 
@@ -950,6 +2270,8 @@ const ShellModuleMethod *hi_exported_methods(void)
 void hi_module_deinit(void)
 {
     moreinfo_del_with_prefix("BENCH");
+    bench_workers_free();
+    bench_index_close();
 }
 
 void hi_module_init(void)
@@ -0,0 +1,292 @@
+/*
+ *    hardinfo2 - System Information and Benchmark
+ *    Copyright (C) 2026 hardinfo2 project
+ *    License: GPL2+
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License v2.0 or later.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/* malloc()/free() throughput of the libc, or of a preloaded allocator.
+ *
+ * Three patterns, each on one thread (one pair for cross) and on all
+ * threads:
+ *  - churn: every thread replaces random entries of its own table of
+ *    blocks of 16-128 bytes;
+ *  - cross: threads in producer/consumer pairs, the producer allocates
+ *    64 byte blocks into a ring, the consumer frees them; every free is of
+ *    another thread's block, the hard case for per-thread caches/arenas;
+ *  - mixed: like churn, sizes mostly small but up to 256 KiB, above the
+ *    usual mmap threshold.
+ * Every block is written to. An op is one malloc() and its free(). RSS is
+ * read from /proc/self/statm before, at the end of the run with all blocks
+ * still held (peak; for cross by the producer with the ring full and by
+ * the consumer once drained), and after everything is freed (held, what the
+ * allocator keeps). Only the RSS of the all threads runs is recorded, one
+ * thread grows it too little to matter. Result is the geometric mean of
+ * Mops/s on all threads. */
+
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+#ifdef __GLIBC__
+#include <gnu/libc-version.h>
+#endif
+
+#include "hardinfo.h"
+#include "benchmark.h"
+
+/* if anything changes in this block, increment revision */
+#define BENCH_REVISION 1
+#define ALLOC_USEC 500000
+#define ALLOC_CHECK 256      /* ops between clock reads */
+#define ALLOC_SLOTS 4096     /* blocks held per churn thread */
+#define ALLOC_MIXED_SLOTS 512 /* per mixed thread, ~3.5 MiB */
+#define ALLOC_RING 4096      /* blocks in flight per cross pair */
+
+typedef struct {
+    gpointer slot[ALLOC_RING];
+    guint head;          /* producer */
+    gchar pad1[60];
+    guint tail;          /* consumer */
+    gchar pad2[60];
+} alloc_ring;
+
+typedef struct {
+    gint test;
+    alloc_ring *rings;   /* per pair */
+    gint64 rss_before;
+    gint64 rss_peak;     /* max seen by a thread, blocks still held */
+    guint64 *ops;        /* per thread */
+} alloc_job;
+
+static gint64 alloc_rss(void)
+{
+    gchar *statm = NULL;
+    gint64 pages = 0;
+
+    if (g_file_get_contents("/proc/self/statm", &statm, NULL, NULL)) {
+        sscanf(statm, "%*s %" G_GINT64_FORMAT, &pages);
+        g_free(statm);
+    }
+    return pages * sysconf(_SC_PAGESIZE);
+}
+
+static inline guint32 alloc_rand(guint32 *x)
+{
+    *x ^= *x << 13;
+    *x ^= *x >> 17;
+    *x ^= *x << 5;
+    return *x;
+}
+
+/* 80% 16-256 B, 15% up to 4 KiB, 5% up to 256 KiB */
+static inline gsize alloc_mixed_size(guint32 *x)
+{
+    guint32 r = alloc_rand(x), p = r % 100;
+
+    if (p < 80) return 16 + (r >> 8) % 241;
+    if (p < 95) return 256 + (r >> 8) % 3841;
+    return 4096 + (r >> 8) % (256 * 1024 - 4095);
+}
+
+static void alloc_note_peak(alloc_job *job)
+{
+    gint64 rss = alloc_rss(), seen = __atomic_load_n(&job->rss_peak, __ATOMIC_RELAXED);
+
+    while (rss > seen &&
+           !__atomic_compare_exchange_n(&job->rss_peak, &seen, rss, FALSE,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        ;
+}
+
+static guint64 alloc_table(alloc_job *job, gint thread_number)
+{
+    guint slots = job->test == BENCH_ALLOC_MIXED ? ALLOC_MIXED_SLOTS : ALLOC_SLOTS;
+    gpointer *slot = g_new0(gpointer, slots);
+    guint32 x = 2463534242u + thread_number * 7919;
+    gint64 t0 = bench_time_usec();
+    guint64 ops = 0;
+    gsize size;
+    guint i, k;
+
+    do {
+        for (k = 0; k < ALLOC_CHECK; k++, ops++) {
+            i = alloc_rand(&x) % slots;
+            size = job->test == BENCH_ALLOC_MIXED ? alloc_mixed_size(&x) : 16 + alloc_rand(&x) % 113;
+            free(slot[i]);
+            slot[i] = malloc(size);
+            if (slot[i]) *(volatile gchar *)slot[i] = (gchar)ops;
+        }
+    } while (bench_time_usec() - t0 < ALLOC_USEC);
+
+    alloc_note_peak(job);
+    for (i = 0; i < slots; i++)
+        free(slot[i]);
+    g_free(slot);
+    return ops;
+}
+
+static guint64 alloc_produce(alloc_job *job, alloc_ring *ring)
+{
+    gint64 t0 = bench_time_usec();
+    guint64 ops = 0;
+    gpointer p;
+    guint head = 0, k;
+
+    do {
+        for (k = 0; k < ALLOC_CHECK; k++) {
+            while (head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) >= ALLOC_RING)
+                g_thread_yield();
+            p = malloc(64);
+            if (p) *(volatile gchar *)p = (gchar)k;
+            ring->slot[head % ALLOC_RING] = p;
+            __atomic_store_n(&ring->head, ++head, __ATOMIC_RELEASE);
+            ops++;
+        }
+    } while (bench_time_usec() - t0 < ALLOC_USEC);
+
+    alloc_note_peak(job);
+    /* end of stream */
+    while (head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) >= ALLOC_RING)
+        g_thread_yield();
+    ring->slot[head % ALLOC_RING] = GINT_TO_POINTER(-1);
+    __atomic_store_n(&ring->head, ++head, __ATOMIC_RELEASE);
+    return ops;
+}
+
+static guint64 alloc_consume(alloc_job *job, alloc_ring *ring)
+{
+    guint64 ops = 0;
+    gpointer p;
+    guint tail = 0;
+
+    for (;;) {
+        while (tail == __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE))
+            g_thread_yield();
+        p = ring->slot[tail % ALLOC_RING];
+        __atomic_store_n(&ring->tail, ++tail, __ATOMIC_RELEASE);
+        if (p == GINT_TO_POINTER(-1))
+            break;
+        free(p);
+        ops++;
+    }
+    alloc_note_peak(job);
+    return ops;
+}
+
+static gpointer alloc_thread(unsigned int start, unsigned int end, void *data, gint thread_number)
+{
+    alloc_job *job = (alloc_job *)data;
+
+    if (job->test != BENCH_ALLOC_CROSS)
+        job->ops[thread_number] = alloc_table(job, thread_number);
+    else if (thread_number % 2 == 0)
+        alloc_produce(job, &job->rings[thread_number / 2]);
+    else
+        job->ops[thread_number] = alloc_consume(job, &job->rings[thread_number / 2]);
+    return NULL;
+}
+
+/* Mops/s of all threads, peak and held RSS growth in MiB if rss_peak */
+static void alloc_run(gint test, gint threads, float *mops, float *rss_peak, float *rss_held)
+{
+    alloc_job job = { .test = test };
+    guint64 ops = 0;
+    bench_value v;
+    gint t;
+
+    if (test == BENCH_ALLOC_CROSS)
+        threads = MAX(2, threads & ~1);
+    job.rings = g_new0(alloc_ring, threads / 2 + 1);
+    job.ops = g_new0(guint64, threads);
+    job.rss_before = job.rss_peak = alloc_rss();
+
+    v = benchmark_parallel(threads, alloc_thread, &job);
+    for (t = 0; t < threads; t++)
+        ops += job.ops[t];
+    *mops = v.elapsed_time > 0 ? ops / v.elapsed_time / 1e6 : -1;
+    if (rss_peak) {
+        *rss_peak = (job.rss_peak - job.rss_before) / 1048576.0;
+        *rss_held = (alloc_rss() - job.rss_before) / 1048576.0;
+    }
+
+    g_free(job.rings);
+    g_free(job.ops);
+}
+
+/* libc, and an allocator from LD_PRELOAD */
+static gchar *alloc_name(void)
+{
+    const gchar *preload = g_getenv("LD_PRELOAD");
+    gchar *libc, *ret;
+
+#ifdef __GLIBC__
+    libc = g_strdup_printf("glibc %s", gnu_get_libc_version());
+#else
+    libc = g_strdup("libc"); /* musl has no version macro */
+#endif
+    if (preload && *preload) {
+        gchar *base = g_path_get_basename(preload);
+        ret = g_strdup_printf("%s, preload %s", libc, base);
+        g_free(base);
+        g_free(libc);
+        return ret;
+    }
+    return libc;
+}
+
+void benchmark_alloc(void)
+{
+    static const gchar *tests[BENCH_ALLOC_TESTS] = { "churn", "cross", "mixed" };
+    bench_value r = EMPTY_BENCH_VALUE;
+    int cpu_cores, cpu_threads, test, all;
+    double log_sum = 0;
+    gchar *name;
+    GTimer *timer;
+
+    shell_view_set_enabled(FALSE);
+    shell_status_update("Running memory allocator benchmark...");
+
+    bench_workers_cores_threads(&cpu_cores, &cpu_threads);
+    cpu_threads = MAX(cpu_threads, 1);
+
+    timer = g_timer_new();
+    for (test = 0; test < BENCH_ALLOC_TESTS; test++)
+        for (all = 0; all < 2; all++)
+            alloc_run(test, all ? cpu_threads : 1, &r.alloc_mops[test][all],
+                      all ? &r.alloc_rss[test][0] : NULL, all ? &r.alloc_rss[test][1] : NULL);
+    r.elapsed_time = g_timer_elapsed(timer, NULL);
+    g_timer_destroy(timer);
+    r.alloc_tests = BENCH_ALLOC_TESTS;
+
+    for (test = 0; test < BENCH_ALLOC_TESTS; test++)
+        log_sum += log(MAX(r.alloc_mops[test][1], 1e-6));
+    r.result = exp(log_sum / BENCH_ALLOC_TESTS);
+    r.threads_used = cpu_threads;
+
+    name = alloc_name();
+    snprintf(r.extra, sizeof(r.extra), "%s; %d threads Mops/s per thread", name, cpu_threads);
+    for (test = 0; test < BENCH_ALLOC_TESTS; test++)
+        snprintf(r.extra + strlen(r.extra), sizeof(r.extra) - strlen(r.extra),
+                 "%s %s %.1f (1 thread %.1f), RSS +%.1f/%.1f MiB", test ? "," : "",
+                 tests[test],
+                 r.alloc_mops[test][1] / (test == BENCH_ALLOC_CROSS ? MAX(2, cpu_threads & ~1) : cpu_threads),
+                 r.alloc_mops[test][0] / (test == BENCH_ALLOC_CROSS ? 2 : 1),
+                 r.alloc_rss[test][0], r.alloc_rss[test][1]);
+    g_free(name);
+
+    r.revision = BENCH_REVISION;
+    bench_results[BENCHMARK_ALLOC] = r;
+}
@@ -0,0 +1,167 @@
+/*
+ *    hardinfo2 - System Information and Benchmark
+ *    Copyright (C) 2026 hardinfo2 project
+ *    License: GPL2+
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License v2.0 or later.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/* Hardware performance counters for --bench-counters.
+ *
+ * Each worker opens its own user space only counters (pid 0, any cpu) for
+ * the duration of a job, so kernel.perf_event_paranoid up to 2 is enough.
+ * Counters are opened one by one, not as a group: when there are more events
+ * than PMU counters the kernel multiplexes them and the values are scaled by
+ * time enabled/running. Events the cpu or the kernel does not offer are just
+ * left out; if none open the result is marked as not available. */
+
+#include <unistd.h>
+#include <errno.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "hardinfo.h"
+#include "benchmark.h"
+
+#ifndef PERF_PMU_TYPE_SHIFT
+#define PERF_PMU_TYPE_SHIFT 32
+#endif
+
+static const guint64 bench_counter_events[BENCH_COUNTERS] = {
+    [BENCH_COUNTER_CYCLES] = PERF_COUNT_HW_CPU_CYCLES,
+    [BENCH_COUNTER_INSTRUCTIONS] = PERF_COUNT_HW_INSTRUCTIONS,
+    [BENCH_COUNTER_CACHE_REFS] = PERF_COUNT_HW_CACHE_REFERENCES,
+    [BENCH_COUNTER_CACHE_MISSES] = PERF_COUNT_HW_CACHE_MISSES,
+    [BENCH_COUNTER_BRANCHES] = PERF_COUNT_HW_BRANCH_INSTRUCTIONS,
+    [BENCH_COUNTER_BRANCH_MISSES] = PERF_COUNT_HW_BRANCH_MISSES,
+    [BENCH_COUNTER_STALLED_FRONTEND] = PERF_COUNT_HW_STALLED_CYCLES_FRONTEND,
+    [BENCH_COUNTER_STALLED_BACKEND] = PERF_COUNT_HW_STALLED_CYCLES_BACKEND,
+};
+
+static int bench_counter_open(guint64 event, gint pmu_type)
+{
+    struct perf_event_attr attr;
+    int fd;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = event;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    /* hybrid cpus: the PMU of the core class the worker is pinned to */
+    if (pmu_type > 0) {
+        attr.config = event | ((guint64)pmu_type << PERF_PMU_TYPE_SHIFT);
+        fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        if (fd >= 0) return fd;
+        attr.config = event; /* kernel before 5.13 */
+    }
+    return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/* open, disabled, for the calling thread */
+void bench_counters_open(bench_counters *c, gint pmu_type)
+{
+    int i;
+
+    memset(c, 0, sizeof(*c));
+    for (i = 0; i < BENCH_COUNTERS; i++)
+        c->fd[i] = bench_counter_open(bench_counter_events[i], pmu_type);
+}
+
+void bench_counters_enable(bench_counters *c)
+{
+    int i;
+
+    for (i = 0; i < BENCH_COUNTERS; i++)
+        if (c->fd[i] >= 0)
+            ioctl(c->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+}
+
+/* stop, read scaled values and close; valid has a bit for each read counter */
+void bench_counters_close(bench_counters *c)
+{
+    guint64 v[3]; /* value, time enabled, time running */
+    int i;
+
+    for (i = 0; i < BENCH_COUNTERS; i++)
+        if (c->fd[i] >= 0)
+            ioctl(c->fd[i], PERF_EVENT_IOC_DISABLE, 0);
+
+    for (i = 0; i < BENCH_COUNTERS; i++) {
+        if (c->fd[i] < 0) continue;
+        if (read(c->fd[i], v, sizeof(v)) == sizeof(v) && v[2] > 0) {
+            c->value[i] = (v[2] < v[1]) ? (guint64)((double)v[0] * v[1] / v[2]) : v[0];
+            c->valid |= 1 << i;
+        }
+        close(c->fd[i]);
+        c->fd[i] = -1;
+    }
+}
+
+/* sum of all threads, a counter is only valid if read on all of them */
+void bench_counters_add(bench_counters *sum, const bench_counters *c, gboolean first)
+{
+    int i;
+
+    for (i = 0; i < BENCH_COUNTERS; i++)
+        sum->value[i] += c->value[i];
+    sum->valid = first ? c->valid : (sum->valid & c->valid);
+}
+
+static gint bench_counters_paranoid(void)
+{
+    gchar *buf;
+    gint level = -99;
+
+    if (g_file_get_contents("/proc/sys/kernel/perf_event_paranoid", &buf, NULL, NULL)) {
+        level = atoi(buf);
+        g_free(buf);
+    }
+    return level;
+}
+
+/* IPC, MPKI, miss rates and stalls from the summed counters, -1 for unknown */
+void bench_counters_result(bench_value *r, const bench_counters *sum)
+{
+#define HAS(counter) (sum->valid & (1 << BENCH_COUNTER_##counter))
+#define VAL(counter) ((double)sum->value[BENCH_COUNTER_##counter])
+#define RATIO(a, b) ((HAS(a) && HAS(b) && VAL(b) > 0) ? VAL(a) / VAL(b) : -1)
+
+    if (!sum->valid) {
+        static gboolean told = FALSE;
+        if (!told)
+            DEBUG("no hardware counters available (kernel.perf_event_paranoid=%d)",
+                  bench_counters_paranoid());
+        told = TRUE;
+        r->counters = -1;
+        return;
+    }
+
+    r->counters = 1;
+    r->ipc = RATIO(INSTRUCTIONS, CYCLES);
+    r->mpki = RATIO(CACHE_MISSES, INSTRUCTIONS);
+    if (r->mpki >= 0) r->mpki *= 1000;
+    r->cache_miss_rate = RATIO(CACHE_MISSES, CACHE_REFS);
+    r->branch_miss_rate = RATIO(BRANCH_MISSES, BRANCHES);
+    r->stalled_frontend = RATIO(STALLED_FRONTEND, CYCLES);
+    r->stalled_backend = RATIO(STALLED_BACKEND, CYCLES);
+
+#undef RATIO
+#undef VAL
+#undef HAS
+}
@@ -0,0 +1,224 @@
+/*
+ *    hardinfo2 - System Information and Benchmark
+ *    Copyright (C) 2026 hardinfo2 project
+ *    License: GPL2+
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License v2.0 or later.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/* Energy of a benchmark run.
+ *
+ * Read before and after the run, from the first source that is readable:
+ *  - powercap package zones (intel-rapl, also used for AMD), energy_uj,
+ *    wrapping at max_energy_range_uj; the mmio copies are skipped;
+ *  - hwmon energyN_input counters in uJ (amd_energy and meters), only the
+ *    socket/package ones if a device labels them, as it also has per core
+ *    counters; these are 64 bit (amd_energy) and do not wrap in a run, so
+ *    one that goes back was reset or misread;
+ *  - hwmon powerN_input in uW, as the sensors module lists them, of the
+ *    cpu chips only (a gpu, battery or psu meter is not the run's); these
+ *    are instantaneous, so the average of the two readings is used.
+ * energy_uj is root only on most kernels, so as a user often only hwmon is
+ * left. The hwmon devices are found the way modules/devices/sensors.c does,
+ * under hwmonN/ and hwmonN/device/. */
+
+#define _GNU_SOURCE
+#include <string.h>
+
+#include "hardinfo.h"
+#include "benchmark.h"
+
+#define ENERGY_MAX 16
+
+enum { ENERGY_RAPL, ENERGY_HWMON, ENERGY_HWMON_POWER };
+
+static const gchar *energy_source_name[] = { "RAPL package", "hwmon energy", "hwmon power" };
+
+struct bench_energy {
+    gint source;
+    gint n;
+    gchar *path[ENERGY_MAX];
+    guint64 start[ENERGY_MAX];
+    guint64 range[ENERGY_MAX];  /* wraps here, 0 if not known */
+    gint64 t0;
+};
+
+static gboolean energy_read(const gchar *path, guint64 *value)
+{
+    gchar *buf = NULL;
+    gboolean ok = FALSE;
+
+    if (g_file_get_contents(path, &buf, NULL, NULL)) {
+        *value = g_ascii_strtoull(buf, NULL, 10);
+        ok = TRUE;
+        g_free(buf);
+    }
+    return ok;
+}
+
+static void energy_add(bench_energy *e, gchar *path, guint64 range)
+{
+    if (e->n < ENERGY_MAX && energy_read(path, &e->start[e->n])) {
+        e->path[e->n] = path;
+        e->range[e->n++] = range;
+    } else {
+        g_free(path);
+    }
+}
+
+static void energy_rapl(bench_energy *e)
+{
+    GDir *dir = g_dir_open("/sys/class/powercap", 0, NULL);
+    const gchar *zone;
+    gchar *tmp, *name;
+    guint64 range;
+
+    if (!dir) return;
+    while ((zone = g_dir_read_name(dir))) {
+        if (strstr(zone, "mmio"))
+            continue;
+        tmp = g_strdup_printf("/sys/class/powercap/%s/name", zone);
+        name = NULL;
+        g_file_get_contents(tmp, &name, NULL, NULL);
+        g_free(tmp);
+        if (name && g_str_has_prefix(name, "package")) {
+            tmp = g_strdup_printf("/sys/class/powercap/%s/max_energy_range_uj", zone);
+            if (!energy_read(tmp, &range)) range = 0;
+            g_free(tmp);
+            energy_add(e, g_strdup_printf("/sys/class/powercap/%s/energy_uj", zone), range);
+        }
+        g_free(name);
+    }
+    g_dir_close(dir);
+}
+
+/* kind "energy" or "power"; sockets only from devices that label them,
+ * power only from cpu chips */
+static void energy_hwmon(bench_energy *e, const gchar *kind)
+{
+    static const char *prefix[] = { "device/", "", NULL };
+    gchar *path, *tmp, *label, *name;
+    gint hwmon, p, id, n_dev;
+    gint ids[ENERGY_MAX];
+    gboolean sockets;
+    const gchar *file;
+    GDir *dir;
+
+    for (hwmon = 0; e->n < ENERGY_MAX; hwmon++) {
+        path = g_strdup_printf("/sys/class/hwmon/hwmon%d", hwmon);
+        if (!g_file_test(path, G_FILE_TEST_EXISTS)) {
+            g_free(path);
+            break;
+        }
+        if (SEQ(kind, "power")) {
+            tmp = g_strdup_printf("%s/name", path);
+            name = NULL;
+            g_file_get_contents(tmp, &name, NULL, NULL);
+            g_free(tmp);
+            if (!name || !bench_hwmon_cpu_chip(name)) {
+                g_free(name);
+                g_free(path);
+                continue;
+            }
+            g_free(name);
+        }
+        for (p = 0; prefix[p]; p++) {
+            tmp = g_strdup_printf("%s/%s", path, prefix[p]);
+            dir = g_dir_open(tmp, 0, NULL);
+            g_free(tmp);
+            if (!dir) continue;
+
+            n_dev = 0;
+            sockets = FALSE;
+            while ((file = g_dir_read_name(dir)) && n_dev < ENERGY_MAX) {
+                if (!g_str_has_prefix(file, kind) || !g_str_has_suffix(file, "_input") ||
+                    sscanf(file + strlen(kind), "%d", &id) != 1)
+                    continue;
+                tmp = g_strdup_printf("%s/%s%s%d_label", path, prefix[p], kind, id);
+                label = NULL;
+                g_file_get_contents(tmp, &label, NULL, NULL);
+                g_free(tmp);
+                if (label && (strcasestr(label, "socket") || strcasestr(label, "package"))) {
+                    if (!sockets) n_dev = 0;
+                    sockets = TRUE;
+                    ids[n_dev++] = id;
+                } else if (!sockets) {
+                    ids[n_dev++] = id;
+                }
+                g_free(label);
+            }
+            g_dir_close(dir);
+
+            for (id = 0; id < n_dev; id++)
+                energy_add(e, g_strdup_printf("%s/%s%s%d_input", path, prefix[p], kind, ids[id]), 0);
+        }
+        g_free(path);
+    }
+}
+
+bench_energy *bench_energy_start(void)
+{
+    bench_energy *e = g_new0(bench_energy, 1);
+
+    e->source = ENERGY_RAPL;
+    energy_rapl(e);
+    if (!e->n) {
+        e->source = ENERGY_HWMON;
+        energy_hwmon(e, "energy");
+    }
+    if (!e->n) {
+        e->source = ENERGY_HWMON_POWER;
+        energy_hwmon(e, "power");
+    }
+    if (!e->n) {
+        g_free(e);
+        return NULL;
+    }
+    e->t0 = g_get_monotonic_time();
+    return e;
+}
+
+void bench_energy_stop(bench_energy *e, bench_value *r)
+{
+    double joules = 0, seconds;
+    gboolean unknown = FALSE;
+    guint64 now;
+    gint i;
+
+    if (!e) return;
+    seconds = (g_get_monotonic_time() - e->t0) / 1e6;
+
+    for (i = 0; i < e->n; i++) {
+        if (!energy_read(e->path[i], &now))
+            continue;
+        if (e->source == ENERGY_HWMON_POWER)
+            joules += (now + e->start[i]) / 2.0 / 1e6 * seconds;
+        else if (now >= e->start[i])
+            joules += (now - e->start[i]) / 1e6;
+        else if (e->range[i] > e->start[i])
+            joules += (e->range[i] - e->start[i] + now) / 1e6;
+        else
+            unknown = TRUE; /* went back with no known wrap, a part would be missing */
+    }
+
+    if (!unknown && seconds > 0 && joules > 0) {
+        r->energy_j = joules;
+        r->power_w = joules / seconds;
+        r->score_per_watt = r->result > 0 ? r->result / r->power_w : -1;
+        g_strlcpy(r->power_source, energy_source_name[e->source], sizeof(r->power_source));
+    }
+
+    for (i = 0; i < e->n; i++)
+        g_free(e->path[i]);
+    g_free(e);
+}
@@ -0,0 +1,492 @@
+/*
+ *    hardinfo2 - System Information and Benchmark
+ *    Copyright (C) 2026 hardinfo2 project
+ *    License: GPL2+
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License v2.0 or later.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/* Compiled benchmark.json.
+ *
+ * benchmark.json is parsed once, after it changed (sync), into benchmark.idx
+ * in the user config dir, which is then mmap'd. Showing a results page is a
+ * binary search in the benchmark's sorted scores, and only the shown window
+ * of results is turned back into bench_result.
+ *
+ * Layout, native byte order as it is a local cache:
+ *   bench_index_header
+ *   bench_index_benchmark[n_benchmarks]
+ *   double scores[n_records]              each benchmark's range ascending
+ *   bench_index_record records[n_records] same order as scores
+ *   strings                               interned, NUL terminated
+ */
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define BENCH_INDEX_MAGIC "HIBIDX\0\0"
+#define BENCH_INDEX_VERSION 1
+#define BENCH_INDEX_NONE G_MAXUINT32 /* NULL string */
+
+typedef struct {
+    char magic[8];
+    guint32 version;
+    guint32 record_size;
+    gint64 source_mtime;
+    gint64 source_size;
+    guint32 source_path;
+    guint32 n_benchmarks;
+    guint32 n_records;
+    guint32 strings_size;
+} bench_index_header;
+
+typedef struct {
+    guint32 name;
+    guint32 first, count;
+} bench_index_benchmark;
+
+typedef struct {
+    double elapsed_time;
+    guint64 memory_kiB, memory_phys_MiB;
+    gint32 threads_used, revision, legacy;
+    gint32 processors, cores, threads, nodes;
+    gint32 ptr_bits, is_su_data, machine_data_version;
+    /* strings; fields is bench_value_fields_to_str() */
+    guint32 extra, fields;
+    guint32 board, cpu_name, cpu_desc, cpu_config, ogl_renderer, gpu_desc;
+    guint32 mid, ram_types, machine_type, gpu_name, storage;
+} bench_index_record;
+
+typedef struct {
+    gchar *source;
+    gint64 mtime, size;
+    gpointer map;
+    gsize map_size;
+    const bench_index_header *header;
+    const bench_index_benchmark *benchmarks;
+    const double *scores;
+    const bench_index_record *records;
+    const gchar *strings;
+} bench_index;
+
+static bench_index *bench_idx = NULL;
+
+#define BENCH_INDEX_ALIGN(x) (((x) + 7) & ~(gsize)7)
+
+static gsize bench_index_scores_offset(guint32 n_benchmarks)
+{
+    return BENCH_INDEX_ALIGN(sizeof(bench_index_header) +
+                             n_benchmarks * sizeof(bench_index_benchmark));
+}
+
+static gsize bench_index_records_offset(guint32 n_benchmarks, guint32 n_records)
+{
+    return BENCH_INDEX_ALIGN(bench_index_scores_offset(n_benchmarks) +
+                             n_records * sizeof(double));
+}
+
+static gsize bench_index_strings_offset(guint32 n_benchmarks, guint32 n_records)
+{
+    return bench_index_records_offset(n_benchmarks, n_records) +
+           n_records * sizeof(bench_index_record);
+}
+
+static gchar *bench_index_path(void)
+{
+    return g_build_filename(g_get_user_config_dir(), "hardinfo2", "benchmark.idx", NULL);
+}
+
+static const gchar *bench_index_str(const bench_index *idx, guint32 offset)
+{
+    if (offset >= idx->header->strings_size)
+        return NULL;
+    return idx->strings + offset;
+}
+
+/* builder */
+typedef struct {
+    GHashTable *interned;
+    GString *strings;
+    GArray *benchmarks;
+    GArray *scores;
+    GArray *records;
+} bench_index_builder;
+
+static guint32 bench_index_intern(bench_index_builder *bb, const gchar *str)
+{
+    gpointer offset;
+    guint32 ret;
+
+    if (!str)
+        return BENCH_INDEX_NONE;
+    if (g_hash_table_lookup_extended(bb->interned, str, NULL, &offset))
+        return GPOINTER_TO_UINT(offset);
+
+    ret = bb->strings->len;
+    g_string_append_len(bb->strings, str, strlen(str) + 1);
+    g_hash_table_insert(bb->interned, g_strdup(str), GUINT_TO_POINTER(ret));
+    return ret;
+}
+
+static gint bench_index_result_sort(gconstpointer a, gconstpointer b)
+{
+    return bench_result_sort(*(bench_result **)a, *(bench_result **)b);
+}
+
+static void bench_index_add_benchmark(JsonObject *object,
+                                      const gchar *member_name,
+                                      JsonNode *member_node,
+                                      gpointer user_data)
+{
+    bench_index_builder *bb = user_data;
+    bench_index_benchmark bm;
+    GPtrArray *results;
+    JsonArray *machines;
+    guint i;
+
+    if (json_node_get_node_type(member_node) != JSON_NODE_ARRAY)
+        return;
+    machines = json_node_get_array(member_node);
+
+    results = g_ptr_array_new_with_free_func((GDestroyNotify)bench_result_free);
+    for (i = 0; i < json_array_get_length(machines); i++) {
+        bench_result *b = bench_result_benchmarkjson(member_name,
+                                  json_array_get_element(machines, i));
+        if (b)
+            g_ptr_array_add(results, b);
+    }
+    g_ptr_array_sort(results, bench_index_result_sort);
+
+    bm.name = bench_index_intern(bb, member_name);
+    bm.first = bb->records->len;
+    bm.count = results->len;
+    g_array_append_val(bb->benchmarks, bm);
+
+    for (i = 0; i < results->len; i++) {
+        bench_result *b = g_ptr_array_index(results, i);
+        bench_machine *m = b->machine;
+        gchar *fields = bench_value_fields_to_str(&b->bvalue);
+        bench_index_record rec = {
+            .elapsed_time = b->bvalue.elapsed_time,
+            .memory_kiB = m->memory_kiB,
+            .memory_phys_MiB = m->memory_phys_MiB,
+            .threads_used = b->bvalue.threads_used,
+            .revision = b->bvalue.revision,
+            .legacy = b->legacy,
+            .processors = m->processors,
+            .cores = m->cores,
+            .threads = m->threads,
+            .nodes = m->nodes,
+            .ptr_bits = m->ptr_bits,
+            .is_su_data = m->is_su_data,
+            .machine_data_version = m->machine_data_version,
+            .extra = bench_index_intern(bb, b->bvalue.extra),
+            .fields = bench_index_intern(bb, fields),
+            .board = bench_index_intern(bb, m->board),
+            .cpu_name = bench_index_intern(bb, m->cpu_name),
+            .cpu_desc = bench_index_intern(bb, m->cpu_desc),
+            .cpu_config = bench_index_intern(bb, m->cpu_config),
+            .ogl_renderer = bench_index_intern(bb, m->ogl_renderer),
+            .gpu_desc = bench_index_intern(bb, m->gpu_desc),
+            .mid = bench_index_intern(bb, m->mid),
+            .ram_types = bench_index_intern(bb, m->ram_types),
+            .machine_type = bench_index_intern(bb, m->machine_type),
+            .gpu_name = bench_index_intern(bb, m->gpu_name),
+            .storage = bench_index_intern(bb, m->storage),
+        };
+
+        g_array_append_val(bb->scores, b->bvalue.result);
+        g_array_append_val(bb->records, rec);
+        g_free(fields);
+    }
+
+    g_ptr_array_free(results, TRUE);
+}
+
+static gboolean bench_index_build(const gchar *json_path,
+                                  const gchar *index_path,
+                                  const struct stat *st)
+{
+    JsonParser *parser;
+    JsonNode *root;
+    GError *error = NULL;
+    bench_index_builder bb;
+    bench_index_header header = {};
+    GByteArray *out;
+    gchar *dir;
+    gboolean ret = FALSE;
+
+    DEBUG("Building benchmark results index %s from %s", index_path, json_path);
+
+    parser = json_parser_new();
+    json_parser_load_from_file(parser, json_path, &error);
+    if (error) {
+        DEBUG("Unable to parse JSON %s %s", json_path, error->message);
+        g_error_free(error);
+        g_object_unref(parser);
+        return FALSE;
+    }
+    root = json_parser_get_root(parser);
+    if (!root || (json_node_get_node_type(root) != JSON_NODE_OBJECT)) {
+        g_object_unref(parser);
+        return FALSE;
+    }
+
+    bb.interned = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+    bb.strings = g_string_new(NULL);
+    bb.benchmarks = g_array_new(FALSE, FALSE, sizeof(bench_index_benchmark));
+    bb.scores = g_array_new(FALSE, FALSE, sizeof(double));
+    bb.records = g_array_new(FALSE, FALSE, sizeof(bench_index_record));
+
+    memcpy(header.magic, BENCH_INDEX_MAGIC, sizeof(header.magic));
+    header.version = BENCH_INDEX_VERSION;
+    header.record_size = sizeof(bench_index_record);
+    header.source_mtime = st->st_mtime;
+    header.source_size = st->st_size;
+    header.source_path = bench_index_intern(&bb, json_path);
+    json_object_foreach_member(json_node_get_object(root), bench_index_add_benchmark, &bb);
+    g_object_unref(parser);
+    header.n_benchmarks = bb.benchmarks->len;
+    header.n_records = bb.records->len;
+    header.strings_size = bb.strings->len;
+
+    out = g_byte_array_sized_new(
+        bench_index_strings_offset(header.n_benchmarks, header.n_records) + bb.strings->len);
+    g_byte_array_append(out, (guint8 *)&header, sizeof(header));
+    g_byte_array_append(out, (guint8 *)bb.benchmarks->data,
+                        bb.benchmarks->len * sizeof(bench_index_benchmark));
+    g_byte_array_set_size(out, bench_index_scores_offset(header.n_benchmarks));
+    g_byte_array_append(out, (guint8 *)bb.scores->data, bb.scores->len * sizeof(double));
+    g_byte_array_set_size(out, bench_index_records_offset(header.n_benchmarks, header.n_records));
+    g_byte_array_append(out, (guint8 *)bb.records->data,
+                        bb.records->len * sizeof(bench_index_record));
+    g_byte_array_append(out, (guint8 *)bb.strings->str, bb.strings->len);
+
+    dir = g_path_get_dirname(index_path);
+    g_mkdir_with_parents(dir, 0755);
+    g_free(dir);
+    ret = g_file_set_contents(index_path, (gchar *)out->data, out->len, NULL);
+    if (!ret)
+        DEBUG("Unable to write %s", index_path);
+
+    g_byte_array_free(out, TRUE);
+    g_hash_table_destroy(bb.interned);
+    g_string_free(bb.strings, TRUE);
+    g_array_free(bb.benchmarks, TRUE);
+    g_array_free(bb.scores, TRUE);
+    g_array_free(bb.records, TRUE);
+
+    return ret;
+}
+
+static void bench_index_close(void)
+{
+    if (!bench_idx)
+        return;
+    munmap(bench_idx->map, bench_idx->map_size);
+    g_free(bench_idx->source);
+    g_free(bench_idx);
+    bench_idx = NULL;
+}
+
+/* NULL if missing, damaged or not built from json_path as it is now */
+static bench_index *bench_index_map(const gchar *index_path,
+                                    const gchar *json_path,
+                                    const struct stat *st)
+{
+    const bench_index_header *h;
+    bench_index *idx;
+    struct stat ist;
+    gpointer map;
+    gsize strings;
+    int fd;
+
+    if ((fd = open(index_path, O_RDONLY)) < 0)
+        return NULL;
+    if (fstat(fd, &ist) != 0 || ist.st_size < (off_t)sizeof(bench_index_header)) {
+        close(fd);
+        return NULL;
+    }
+    map = mmap(NULL, ist.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return NULL;
+
+    h = map;
+    strings = bench_index_strings_offset(h->n_benchmarks, h->n_records);
+    if (memcmp(h->magic, BENCH_INDEX_MAGIC, sizeof(h->magic)) != 0 ||
+        h->version != BENCH_INDEX_VERSION ||
+        h->record_size != sizeof(bench_index_record) ||
+        h->source_mtime != st->st_mtime || h->source_size != st->st_size ||
+        h->n_benchmarks > ist.st_size || h->n_records > ist.st_size ||
+        strings + h->strings_size != (gsize)ist.st_size || h->strings_size == 0 ||
+        ((const gchar *)map)[ist.st_size - 1] != 0) {
+        munmap(map, ist.st_size);
+        return NULL;
+    }
+
+    idx = g_new0(bench_index, 1);
+    idx->map = map;
+    idx->map_size = ist.st_size;
+    idx->header = h;
+    idx->benchmarks = (const bench_index_benchmark *)(h + 1);
+    idx->scores = (const double *)((const gchar *)map + bench_index_scores_offset(h->n_benchmarks));
+    idx->records = (const bench_index_record *)((const gchar *)map +
+                   bench_index_records_offset(h->n_benchmarks, h->n_records));
+    idx->strings = (const gchar *)map + strings;
+
+    if (g_strcmp0(bench_index_str(idx, h->source_path), json_path) != 0) {
+        munmap(map, ist.st_size);
+        g_free(idx);
+        return NULL;
+    }
+
+    idx->source = g_strdup(json_path);
+    idx->mtime = st->st_mtime;
+    idx->size = st->st_size;
+    return idx;
+}
+
+/* index of json_path, (re)built if json_path changed; NULL if that fails */
+static bench_index *bench_index_open(const gchar *json_path)
+{
+    struct stat st;
+    gchar *index_path;
+
+    if (stat(json_path, &st) != 0) {
+        bench_index_close();
+        return NULL;
+    }
+    if (bench_idx && SEQ(bench_idx->source, json_path) &&
+        bench_idx->mtime == st.st_mtime && bench_idx->size == st.st_size)
+        return bench_idx;
+
+    bench_index_close();
+    index_path = bench_index_path();
+    bench_idx = bench_index_map(index_path, json_path, &st);
+    if (!bench_idx && bench_index_build(json_path, index_path, &st))
+        bench_idx = bench_index_map(index_path, json_path, &st);
+    g_free(index_path);
+
+    return bench_idx;
+}
+
+static const bench_index_benchmark *bench_index_find(const bench_index *idx,
+                                                     const gchar *benchmark)
+{
+    guint i;
+
+    for (i = 0; i < idx->header->n_benchmarks; i++) {
+        const bench_index_benchmark *bm = &idx->benchmarks[i];
+        if (SEQ(bench_index_str(idx, bm->name), benchmark) &&
+            (guint64)bm->first + bm->count <= idx->header->n_records)
+            return bm;
+    }
+    return NULL;
+}
+
+static bench_result *bench_index_result(const bench_index *idx,
+                                        const gchar *benchmark,
+                                        guint32 r)
+{
+    const bench_index_record *rec = &idx->records[r];
+    const gchar *fields;
+    bench_result *b;
+
+#define INDEX_STR(s) g_strdup(bench_index_str(idx, rec->s))
+    b = g_new0(bench_result, 1);
+    b->name = g_strdup(benchmark);
+    b->legacy = rec->legacy;
+    b->bvalue = (bench_value){
+        .result = idx->scores[r],
+        .elapsed_time = rec->elapsed_time,
+        .threads_used = rec->threads_used,
+        .revision = rec->revision,
+    };
+    if (bench_index_str(idx, rec->extra))
+        g_strlcpy(b->bvalue.extra, bench_index_str(idx, rec->extra),
+                  sizeof(b->bvalue.extra));
+    if ((fields = bench_index_str(idx, rec->fields)))
+        bench_value_fields_from_str(&b->bvalue, fields);
+
+    b->machine = bench_machine_new();
+    *b->machine = (bench_machine){
+        .board = INDEX_STR(board),
+        .memory_kiB = rec->memory_kiB,
+        .cpu_name = INDEX_STR(cpu_name),
+        .cpu_desc = INDEX_STR(cpu_desc),
+        .cpu_config = INDEX_STR(cpu_config),
+        .ogl_renderer = INDEX_STR(ogl_renderer),
+        .gpu_desc = INDEX_STR(gpu_desc),
+        .processors = rec->processors,
+        .cores = rec->cores,
+        .threads = rec->threads,
+        .nodes = rec->nodes,
+        .mid = INDEX_STR(mid),
+        .ptr_bits = rec->ptr_bits,
+        .is_su_data = rec->is_su_data,
+        .memory_phys_MiB = rec->memory_phys_MiB,
+        .ram_types = INDEX_STR(ram_types),
+        .machine_data_version = rec->machine_data_version,
+        .machine_type = INDEX_STR(machine_type),
+        .gpu_name = INDEX_STR(gpu_name),
+        .storage = INDEX_STR(storage),
+    };
+#undef INDEX_STR
+
+    return b;
+}
+
+/* the results shown for benchmark, in display order, this_machine included */
+static GSList *bench_index_results(const bench_index *idx,
+                                   const gchar *benchmark,
+                                   bench_result *this_machine,
+                                   ShellOrderType order_type)
+{
+    const bench_index_benchmark *bm = bench_index_find(idx, benchmark);
+    const double *scores = bm ? idx->scores + bm->first : NULL;
+    guint count = bm ? bm->count : 0, lo = 0, hi = count, pos, a;
+    gboolean descending = (order_type == SHELL_ORDER_DESCENDING);
+    struct bench_window window;
+    GSList *list = NULL;
+    int len, loc = -1, i;
+
+    /* this machine sorts before results with the same score */
+    if (this_machine) {
+        while (lo < hi) {
+            guint mid = lo + (hi - lo) / 2;
+            if (scores[mid] < this_machine->bvalue.result)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+    }
+    pos = lo;
+    len = count + (this_machine ? 1 : 0);
+    if (this_machine)
+        loc = descending ? len - 1 - pos : pos;
+
+    window = get_bench_window(len, loc);
+    for (i = MIN(window.max, len) - 1; i >= window.min; i--) {
+        a = descending ? len - 1 - i : i;
+        if (this_machine && a == pos)
+            list = g_slist_prepend(list, this_machine);
+        else
+            list = g_slist_prepend(list, bench_index_result(idx, benchmark,
+                       bm->first + a - (this_machine && a > pos ? 1 : 0)));
+    }
+
+    return list;
+}
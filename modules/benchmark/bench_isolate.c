@@ -0,0 +1,157 @@
+/*
+ *    hardinfo2 - System Information and Benchmark
+ *    Copyright (C) 2026 hardinfo2 project
+ *    License: GPL2+
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License v2.0 or later.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/* --bench-isolate: run on a fenced, quiet set of cpus, or say it was not.
+ *
+ * The first run fences the process, and with it the worker pool, to the
+ * cpus of the list ("all" keeps them all). Before every run the cpuN lines
+ * of /proc/stat are read twice ISOLATE_PREFLIGHT_USEC apart: the noise
+ * score is the busy share (steal included) of the fenced cpus while this
+ * process is idle, that is what other processes and the hypervisor take.
+ * The load average is the same as modules/computer/loadavg.c reads; in a
+ * batch it also holds the previous benchmark, so it is only recorded.
+ * Above BENCH_NOISE_WARN a warning is printed, above --bench-max-load the
+ * run is refused. getrusage() gives the involuntary context switches of
+ * the run, all threads. */
+
+#define _GNU_SOURCE
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include "hardinfo.h"
+#include "benchmark.h"
+
+#define ISOLATE_PREFLIGHT_USEC 500000
+
+struct bench_isolate {
+    gint cpus;
+    float noise;
+    float load_avg;
+    long nivcsw;
+};
+
+/* busy and total jiffies of the allowed cpus */
+static gboolean isolate_cpu_times(guint64 *busy, guint64 *total)
+{
+    guint64 user, nice, sys, idle, iowait, irq, softirq, steal;
+    gchar *stat = NULL, **lines;
+    cpu_set_t allowed;
+    gint i, cpu;
+
+    *busy = *total = 0;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0 ||
+        !g_file_get_contents("/proc/stat", &stat, NULL, NULL))
+        return FALSE;
+
+    lines = g_strsplit(stat, "\n", 0);
+    for (i = 0; lines[i]; i++) {
+        steal = 0;
+        if (sscanf(lines[i], "cpu%d %" G_GUINT64_FORMAT " %" G_GUINT64_FORMAT " %" G_GUINT64_FORMAT
+                   " %" G_GUINT64_FORMAT " %" G_GUINT64_FORMAT " %" G_GUINT64_FORMAT
+                   " %" G_GUINT64_FORMAT " %" G_GUINT64_FORMAT,
+                   &cpu, &user, &nice, &sys, &idle, &iowait, &irq, &softirq, &steal) < 8 ||
+            cpu < 0 || cpu >= CPU_SETSIZE || !CPU_ISSET(cpu, &allowed))
+            continue;
+        *busy += user + nice + sys + irq + softirq + steal;
+        *total += user + nice + sys + idle + iowait + irq + softirq + steal;
+    }
+    g_strfreev(lines);
+    g_free(stat);
+    return *total > 0;
+}
+
+static float isolate_load_avg(void)
+{
+    gchar *buf = NULL;
+    float load = -1;
+
+    if (g_file_get_contents("/proc/loadavg", &buf, NULL, NULL)) {
+        load = g_ascii_strtod(buf, NULL);
+        g_free(buf);
+    }
+    return load;
+}
+
+static long isolate_nivcsw(void)
+{
+    struct rusage ru;
+
+    return getrusage(RUSAGE_SELF, &ru) == 0 ? ru.ru_nivcsw : 0;
+}
+
+bench_isolate *bench_isolate_start(void)
+{
+    static gint fenced = 0;
+    guint64 busy0, total0, busy1, total1;
+    bench_isolate *iso;
+    cpu_set_t allowed;
+
+    if (!params.bench_isolate)
+        return NULL;
+
+    if (!fenced) {
+        fenced = SEQ(params.bench_isolate, "all") ? -1 : bench_workers_fence(params.bench_isolate);
+        if (!fenced) {
+            fprintf(stderr, _("No allowed cpu in %s, not fenced\n"), params.bench_isolate);
+            fenced = -1;
+        }
+    }
+
+    iso = g_new0(bench_isolate, 1);
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0)
+        iso->cpus = CPU_COUNT(&allowed);
+    iso->noise = -1;
+    if (isolate_cpu_times(&busy0, &total0)) {
+        g_usleep(ISOLATE_PREFLIGHT_USEC);
+        if (isolate_cpu_times(&busy1, &total1) && total1 > total0)
+            iso->noise = 100.0 * (busy1 - busy0) / (total1 - total0);
+    }
+    iso->load_avg = isolate_load_avg();
+    if (iso->noise > BENCH_NOISE_WARN)
+        fprintf(stderr, _("Warning: benchmark cpus %.0f%% busy before the run, load average %.2f\n"),
+                iso->noise, iso->load_avg);
+
+    iso->nivcsw = isolate_nivcsw();
+    return iso;
+}
+
+gboolean bench_isolate_refused(bench_isolate *iso, bench_value *r)
+{
+    if (!iso || params.bench_max_load <= 0 || iso->noise <= params.bench_max_load)
+        return FALSE;
+
+    *r = (bench_value)EMPTY_BENCH_VALUE;
+    snprintf(r->extra, sizeof(r->extra), "refused, cpus %.0f%% busy (max load %d%%), load average %.2f",
+             iso->noise, params.bench_max_load, iso->load_avg);
+    return TRUE;
+}
+
+void bench_isolate_stop(bench_isolate *iso, bench_value *r)
+{
+    if (!iso) return;
+
+    r->isolated_cpus = MAX(iso->cpus, 1);
+    r->noise = iso->noise;
+    r->load_avg = iso->load_avg;
+    r->nivcsw = isolate_nivcsw() - iso->nivcsw;
+    g_free(iso);
+}
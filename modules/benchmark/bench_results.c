@@ -349,6 +349,255 @@ bench_result *bench_result_benchmarkjson(const gchar *bench_name,
              json_get_string(machine, "ExtraInfo"));
     filter_invalid_chars(b->bvalue.extra);
 
+    b->bvalue.trials = CLAMP(json_get_int(machine, "Trials"), 0, BENCH_MAX_TRIALS);
+    if (b->bvalue.trials > 1) {
+        b->bvalue.median = json_get_double(machine, "ResultMedian");
+        b->bvalue.min = json_get_double(machine, "ResultMin");
+        b->bvalue.max = json_get_double(machine, "ResultMax");
+        b->bvalue.stddev = json_get_double(machine, "ResultStdDev");
+        b->bvalue.ci95 = json_get_double(machine, "ResultCI95");
+        if (json_object_has_member(machine, "TrialResults")) {
+            JsonArray *trials = json_object_get_array_member(machine, "TrialResults");
+            guint i, n = trials ? json_array_get_length(trials) : 0;
+            for (i = 0; i < n && i < BENCH_MAX_TRIALS; i++)
+                b->bvalue.trial[i] = json_array_get_double_element(trials, i);
+        }
+    }
+
+    b->bvalue.imbalance = json_get_double(machine, "ThreadImbalance");
+    if (json_object_has_member(machine, "ThroughputSeries")) {
+        JsonArray *series = json_object_get_array_member(machine, "ThroughputSeries");
+        guint i, n = series ? json_array_get_length(series) : 0;
+        for (i = 0; i < n && i < BENCH_MAX_SLICES; i++)
+            b->bvalue.slice[i] = json_array_get_double_element(series, i);
+        b->bvalue.slices = i;
+        b->bvalue.slice_time = json_get_double(machine, "SliceTime");
+        b->bvalue.sustained_ratio = json_get_double(machine, "SustainedRatio");
+        b->bvalue.precision = json_get_double(machine, "RunPrecision");
+    }
+
+    if (json_object_has_member(machine, "SweepThreads") &&
+        json_object_has_member(machine, "SweepThroughput")) {
+        JsonArray *threads = json_object_get_array_member(machine, "SweepThreads");
+        JsonArray *rates = json_object_get_array_member(machine, "SweepThroughput");
+        guint i, n = (threads && rates) ? MIN(json_array_get_length(threads),
+                                              json_array_get_length(rates)) : 0;
+        for (i = 0; i < n && i < BENCH_MAX_SWEEP; i++) {
+            b->bvalue.sweep_threads[i] = json_array_get_int_element(threads, i);
+            b->bvalue.sweep_rate[i] = json_array_get_double_element(rates, i);
+        }
+        b->bvalue.sweep_steps = i;
+        b->bvalue.sweep_knee = json_get_int(machine, "ScalingKnee");
+    }
+
+    if (json_object_has_member(machine, "CoreClassNames") &&
+        json_object_has_member(machine, "CoreClassResults")) {
+        JsonArray *names = json_object_get_array_member(machine, "CoreClassNames");
+        JsonArray *results = json_object_get_array_member(machine, "CoreClassResults");
+        guint i, n = (names && results) ? MIN(json_array_get_length(names),
+                                              json_array_get_length(results)) : 0;
+        for (i = 0; i < n && i < BENCH_MAX_CLASSES; i++) {
+            const gchar *name = json_array_get_string_element(names, i);
+            g_strlcpy(b->bvalue.class_name[i], name ? name : "",
+                      sizeof(b->bvalue.class_name[i]));
+            filter_invalid_chars(b->bvalue.class_name[i]);
+            b->bvalue.class_result[i] = json_array_get_double_element(results, i);
+        }
+        b->bvalue.classes = i;
+    }
+
+    if (json_object_has_member(machine, "CounterIPC")) {
+        b->bvalue.counters = 1;
+        b->bvalue.ipc = json_get_double(machine, "CounterIPC");
+        b->bvalue.mpki = json_get_double(machine, "CounterMPKI");
+        b->bvalue.cache_miss_rate = json_get_double(machine, "CounterCacheMissRate");
+        b->bvalue.branch_miss_rate = json_get_double(machine, "CounterBranchMissRate");
+        b->bvalue.stalled_frontend = json_get_double(machine, "CounterStalledFrontend");
+        b->bvalue.stalled_backend = json_get_double(machine, "CounterStalledBackend");
+    }
+
+    if (json_object_has_member(machine, "PowerWatts")) {
+        const gchar *source = json_get_string(machine, "PowerSource");
+        b->bvalue.energy_j = json_get_double(machine, "EnergyJoules");
+        b->bvalue.power_w = json_get_double(machine, "PowerWatts");
+        b->bvalue.score_per_watt = json_get_double(machine, "ScorePerWatt");
+        g_strlcpy(b->bvalue.power_source, source ? source : "", sizeof(b->bvalue.power_source));
+        filter_invalid_chars(b->bvalue.power_source);
+    }
+
+    if (json_object_has_member(machine, "IsolatedCPUs")) {
+        b->bvalue.isolated_cpus = json_get_int(machine, "IsolatedCPUs");
+        b->bvalue.noise = json_get_double(machine, "NoiseScore");
+        b->bvalue.load_avg = json_get_double(machine, "LoadAverage");
+        b->bvalue.nivcsw = json_get_int(machine, "InvoluntaryCtxSwitches");
+    }
+
+    b->bvalue.errors = json_get_int(machine, "VerifyErrors");
+    b->bvalue.local_input = CLAMP(json_get_int(machine, "LocalInput"),
+                                  BENCH_LOCAL_SHARED, BENCH_LOCAL_HUGETLB);
+
+    if (json_object_has_member(machine, "FreqMHz")) {
+        JsonArray *mhz = json_object_get_array_member(machine, "FreqMHz");
+        guint i;
+        if (mhz && json_array_get_length(mhz) >= 3) {
+            for (i = 0; i < 3; i++)
+                b->bvalue.freq_mhz[i] = json_array_get_double_element(mhz, i);
+            b->bvalue.temp_peak = json_object_has_member(machine, "PeakTempC")
+                ? json_get_double(machine, "PeakTempC") : -1;
+            b->bvalue.throttled = json_get_boolean(machine, "Throttled");
+            b->bvalue.telemetry = 1;
+        }
+    }
+
+    if (json_object_has_member(machine, "LatencySeries")) {
+        JsonArray *series = json_object_get_array_member(machine, "LatencySeries");
+        guint i, n = series ? json_array_get_length(series) : 0;
+        for (i = 0; i < n && i < BENCH_MAX_LATENCY; i++)
+            b->bvalue.latency[i] = json_array_get_double_element(series, i);
+        b->bvalue.latency_steps = i;
+    }
+    if (json_object_has_member(machine, "CacheLevelsKiB")) {
+        JsonArray *levels = json_object_get_array_member(machine, "CacheLevelsKiB");
+        guint i, n = levels ? json_array_get_length(levels) : 0;
+        for (i = 0; i < n && i < BENCH_MAX_LEVELS; i++)
+            b->bvalue.cache_level_kib[i] = json_array_get_int_element(levels, i);
+        b->bvalue.cache_levels = i;
+    }
+
+    if (json_object_has_member(machine, "NumaLatency") &&
+        json_object_has_member(machine, "NumaBandwidth")) {
+        JsonArray *lat = json_object_get_array_member(machine, "NumaLatency");
+        JsonArray *bw = json_object_get_array_member(machine, "NumaBandwidth");
+        int n = CLAMP(json_get_int(machine, "NumaMatrixNodes"), 0, BENCH_MAX_NUMA);
+        guint i;
+        if (lat && bw && json_array_get_length(lat) >= (guint)(n * n) &&
+            json_array_get_length(bw) >= (guint)(n * n)) {
+            for (i = 0; i < (guint)(n * n); i++) {
+                b->bvalue.numa_latency[i / n][i % n] = json_array_get_double_element(lat, i);
+                b->bvalue.numa_bandwidth[i / n][i % n] = json_array_get_double_element(bw, i);
+            }
+            b->bvalue.numa_nodes = n;
+            for (i = 0; i < (guint)n; i++)
+                b->bvalue.numa_id[i] = i;
+            if (json_object_has_member(machine, "NumaNodeIds")) {
+                JsonArray *ids = json_object_get_array_member(machine, "NumaNodeIds");
+                for (i = 0; ids && i < MIN((guint)n, json_array_get_length(ids)); i++)
+                    b->bvalue.numa_id[i] = json_array_get_int_element(ids, i);
+            }
+        }
+    }
+
+    if (json_object_has_member(machine, "StorageIOPS") &&
+        json_object_has_member(machine, "StorageMBs") &&
+        json_object_has_member(machine, "StorageLatency")) {
+        JsonArray *iops = json_object_get_array_member(machine, "StorageIOPS");
+        JsonArray *mbs = json_object_get_array_member(machine, "StorageMBs");
+        JsonArray *lat = json_object_get_array_member(machine, "StorageLatency");
+        guint i, n = (iops && mbs) ? MIN(json_array_get_length(iops),
+                                         json_array_get_length(mbs)) : 0;
+        n = MIN(n, BENCH_STORAGE_TESTS);
+        if (lat && json_array_get_length(lat) >= 3 * n) {
+            for (i = 0; i < n; i++) {
+                b->bvalue.storage_iops[i] = json_array_get_double_element(iops, i);
+                b->bvalue.storage_mbs[i] = json_array_get_double_element(mbs, i);
+            }
+            for (i = 0; i < 3 * n; i++)
+                b->bvalue.storage_lat[i / 3][i % 3] = json_array_get_double_element(lat, i);
+            b->bvalue.storage_tests = n;
+        }
+    }
+
+    if (json_object_has_member(machine, "NetworkGbits") &&
+        json_object_has_member(machine, "NetworkLatency")) {
+        JsonArray *gbits = json_object_get_array_member(machine, "NetworkGbits");
+        JsonArray *lat = json_object_get_array_member(machine, "NetworkLatency");
+        guint i, n = gbits ? MIN(json_array_get_length(gbits), BENCH_NET_TESTS) : 0;
+        if (n && lat && json_array_get_length(lat) >= 3 * BENCH_NET_RTTS) {
+            for (i = 0; i < n; i++)
+                b->bvalue.net_gbits[i] = json_array_get_double_element(gbits, i);
+            for (i = 0; i < 3 * BENCH_NET_RTTS; i++)
+                b->bvalue.net_rtt[i / 3][i % 3] = json_array_get_double_element(lat, i);
+            b->bvalue.net_streams = json_get_int(machine, "NetworkStreams");
+            b->bvalue.net_udp_loss = json_get_double(machine, "NetworkUDPLoss");
+            b->bvalue.net_tests = n;
+        }
+    }
+
+    if (json_object_has_member(machine, "HashMBs")) {
+        JsonArray *mbs = json_object_get_array_member(machine, "HashMBs");
+        guint i, n = mbs ? json_array_get_length(mbs) / BENCH_HASHES : 0;
+        n = MIN(n, BENCH_HASH_PATHS);
+        for (i = 0; i < BENCH_HASHES * n; i++)
+            b->bvalue.hash_mbs[i / n][i % n] = json_array_get_double_element(mbs, i);
+        b->bvalue.hash_paths = n;
+    }
+
+    if (json_object_has_member(machine, "GemmGFLOPS")) {
+        JsonArray *gflops = json_object_get_array_member(machine, "GemmGFLOPS");
+        JsonArray *peak = json_object_get_array_member(machine, "GemmPeakGFLOPS");
+        guint i;
+        if (gflops && json_array_get_length(gflops) >= 2 * BENCH_GEMM_PRECISIONS) {
+            for (i = 0; i < 2 * BENCH_GEMM_PRECISIONS; i++) {
+                b->bvalue.gemm_gflops[i / 2][i % 2] = json_array_get_double_element(gflops, i);
+                b->bvalue.gemm_peak[i / 2][i % 2] =
+                    (peak && json_array_get_length(peak) > i) ? json_array_get_double_element(peak, i) : -1;
+            }
+            b->bvalue.gemm = 1;
+        }
+    }
+
+    if (json_object_has_member(machine, "SyncMops")) {
+        JsonArray *mops = json_object_get_array_member(machine, "SyncMops");
+        JsonArray *fair = json_object_get_array_member(machine, "SyncFairness");
+        guint i, n = mops ? json_array_get_length(mops) / BENCH_SYNC_TESTS : 0;
+        n = MIN(n, BENCH_MAX_SWEEP);
+        for (i = 0; i < BENCH_SYNC_TESTS * n; i++) {
+            b->bvalue.sync_mops[i / n][i % n] = json_array_get_double_element(mops, i);
+            b->bvalue.sync_fair[i / n][i % n] =
+                (fair && json_array_get_length(fair) > i) ? json_array_get_double_element(fair, i) : -1;
+        }
+        if (n > 0) b->bvalue.sync_tests = BENCH_SYNC_TESTS;
+    }
+
+    if (json_object_has_member(machine, "AllocMops")) {
+        JsonArray *mops = json_object_get_array_member(machine, "AllocMops");
+        JsonArray *rss = json_object_get_array_member(machine, "AllocRSSMiB");
+        guint i;
+        if (mops && json_array_get_length(mops) >= 2 * BENCH_ALLOC_TESTS) {
+            for (i = 0; i < 2 * BENCH_ALLOC_TESTS; i++) {
+                b->bvalue.alloc_mops[i / 2][i % 2] = json_array_get_double_element(mops, i);
+                b->bvalue.alloc_rss[i / 2][i % 2] =
+                    (rss && json_array_get_length(rss) > i) ? json_array_get_double_element(rss, i) : 0;
+            }
+            b->bvalue.alloc_tests = BENCH_ALLOC_TESTS;
+        }
+    }
+
+    if (json_object_has_member(machine, "CoreToCoreLatency")) {
+        JsonArray *cpus = json_object_get_array_member(machine, "CoreToCoreCpus");
+        JsonArray *groups = json_object_get_array_member(machine, "CoreToCoreGroups");
+        JsonArray *sockets = json_object_get_array_member(machine, "CoreToCoreSockets");
+        JsonArray *lat = json_object_get_array_member(machine, "CoreToCoreLatency");
+        guint i, n = (cpus && groups && sockets) ?
+            MIN(json_array_get_length(cpus), MIN(json_array_get_length(groups),
+                                                 json_array_get_length(sockets))) : 0;
+        n = MIN(n, BENCH_MAX_C2C);
+        if (lat && json_array_get_length(lat) >= n * n) {
+            for (i = 0; i < n; i++) {
+                b->bvalue.c2c_unit_cpu[i] = json_array_get_int_element(cpus, i);
+                b->bvalue.c2c_unit_group[i] = json_array_get_int_element(groups, i);
+                b->bvalue.c2c_unit_socket[i] = json_array_get_int_element(sockets, i);
+            }
+            for (i = 0; i < n * n; i++)
+                b->bvalue.c2c_latency[i / n][i % n] = json_array_get_double_element(lat, i);
+            b->bvalue.c2c_kind[BENCH_C2C_SMT] = json_get_double(machine, "CoreToCoreSMT");
+            b->bvalue.c2c_kind[BENCH_C2C_CCX] = json_get_double(machine, "CoreToCoreCCX");
+            b->bvalue.c2c_kind[BENCH_C2C_CROSS_CCX] = json_get_double(machine, "CoreToCoreCrossCCX");
+            b->bvalue.c2c_kind[BENCH_C2C_SOCKET] = json_get_double(machine, "CoreToCoreCrossSocket");
+            b->bvalue.c2c_units = n;
+        }
+    }
+
     int nodes = json_get_int(machine, "NumNodes");
 
     if (nodes == 0)
@@ -382,6 +631,600 @@ bench_result *bench_result_benchmarkjson(const gchar *bench_name,
     return b;
 }
 
+/* --bench-repeat statistics, empty if a single run */
+static char *bench_result_stats_section(bench_result *b)
+{
+    gchar *trials = NULL, *ret;
+    int i;
+
+    if (b->bvalue.trials < 2)
+        return g_strdup("");
+
+    for (i = 0; i < b->bvalue.trials; i++)
+        trials = appf(trials, " ", "%.2f", b->bvalue.trial[i]);
+
+    ret = g_strdup_printf(
+        "[%s]\n"
+        /* trials */ "%s=%d\n"
+        /* median */ "%s=%.2f\n"
+        /* min */ "%s=%.2f\n"
+        /* max */ "%s=%.2f\n"
+        /* stddev */ "%s=%.4f\n"
+        /* ci95 */ "%s=\u00b1%.4f (\u00b1%.2f%%)\n"
+        /* values */ "%s=%s\n",
+        _("Statistics"),
+        _("Trials"), b->bvalue.trials,
+        _("Median"), b->bvalue.median,
+        _("Minimum"), b->bvalue.min,
+        _("Maximum"), b->bvalue.max,
+        _("Standard Deviation"), b->bvalue.stddev,
+        _("95% Confidence Interval"), b->bvalue.ci95,
+        (b->bvalue.median > 0) ? 100 * b->bvalue.ci95 / b->bvalue.median : 0.0,
+        _("Trial Results"), trials);
+    g_free(trials);
+    return ret;
+}
+
+/* throughput over the run, empty if not recorded */
+static char *bench_result_throughput_section(bench_result *b)
+{
+    static const char *local_input[] = {
+        NULL, N_("copy per worker"), N_("copy per worker, transparent huge pages"),
+        N_("copy per worker, hugetlbfs pages") };
+    gchar *series = NULL, *imbalance, *ret;
+    int i;
+
+    if (b->bvalue.slices < 1 && b->bvalue.imbalance <= 0 &&
+        b->bvalue.local_input <= BENCH_LOCAL_SHARED && b->bvalue.errors <= 0)
+        return g_strdup("");
+
+    for (i = 0; i < b->bvalue.slices; i++)
+        series = appf(series, " ", "%.0f", 100 * b->bvalue.slice[i]);
+    imbalance = g_strdup_printf("%.1f%%", 100 * b->bvalue.imbalance);
+
+    if (b->bvalue.slices < 1 && b->bvalue.imbalance <= 0)
+        ret = g_strdup_printf("[%s]\n", _("Throughput"));
+    else if (b->bvalue.slices < 1)
+        ret = g_strdup_printf("[%s]\n%s=%s\n", _("Throughput"),
+                              _("Thread Imbalance"), imbalance);
+    else
+        ret = g_strdup_printf(
+            "[%s]\n"
+            /* slice */ "%s=%.0f %s\n"
+            /* ratio */ "%s=%.2f\n"
+            /* imbalance */ "%s=%s\n"
+            /* series */ "%s=%s\n",
+            _("Throughput"),
+            _("Slice Time"), 1000 * b->bvalue.slice_time, _("ms"),
+            _("Sustained/Burst"), b->bvalue.sustained_ratio,
+            _("Thread Imbalance"), imbalance,
+            _("Series (% of average)"), series);
+    if (b->bvalue.slices > 0 && b->bvalue.precision > 0)
+        ret = h_strdup_cprintf("%s=\302\261%.2f%% (%s)\n", ret, _("Run Precision"),
+                               100 * b->bvalue.precision, _("95% CI, adaptive length"));
+    if (b->bvalue.local_input > BENCH_LOCAL_SHARED)
+        ret = h_strdup_cprintf("%s=%s\n", ret, _("Worker Input"),
+                               _(local_input[b->bvalue.local_input]));
+    if (b->bvalue.errors > 0)
+        ret = h_strdup_cprintf("%s=%d%s\n", ret, _("Failed Checks"), b->bvalue.errors,
+                               problem_marker());
+    g_free(series);
+    g_free(imbalance);
+    return ret;
+}
+
+/* --bench-sweep steps, empty if not swept */
+static char *bench_result_scaling_section(bench_result *b)
+{
+    gchar *ret;
+    double base = b->bvalue.sweep_rate[0];
+    int i;
+
+    if (b->bvalue.sweep_steps < 1 || base <= 0)
+        return g_strdup("");
+
+    ret = g_strdup_printf("[%s]\n%s=%d\n", _("Thread Scaling"),
+                          _("Knee (threads)"), b->bvalue.sweep_knee);
+    for (i = 0; i < b->bvalue.sweep_steps; i++) {
+        double speedup = b->bvalue.sweep_rate[i] / base;
+        ret = h_strdup_cprintf("%d %s=%.2f/s, %s %.2fx, %s %.0f%%\n", ret,
+                               b->bvalue.sweep_threads[i], _("Threads"),
+                               b->bvalue.sweep_rate[i],
+                               _("speedup"), speedup,
+                               _("efficiency"), 100 * speedup / b->bvalue.sweep_threads[i]);
+    }
+    return ret;
+}
+
+/* --bench-classes results, empty if not run */
+static char *bench_result_classes_section(bench_result *b)
+{
+    gchar *ret;
+    int i;
+
+    if (b->bvalue.classes < 1)
+        return g_strdup("");
+
+    ret = g_strdup_printf("[%s]\n%s=%.2f\n", _("Core Classes"),
+                          _("Mixed"), b->bvalue.result);
+    for (i = 0; i < b->bvalue.classes; i++)
+        ret = h_strdup_cprintf("%s=%.2f\n", ret, b->bvalue.class_name[i],
+                               b->bvalue.class_result[i]);
+    return ret;
+}
+
+/* --bench-counters ratios, empty if not asked for */
+static char *bench_result_counters_section(bench_result *b)
+{
+    gchar *ret;
+
+    if (b->bvalue.counters == 0)
+        return g_strdup("");
+    if (b->bvalue.counters < 0)
+        return g_strdup_printf("[%s]\n%s=%s\n", _("Hardware Counters"),
+                               _("Counters"), _("Not available (perf_event_paranoid?)"));
+
+#define COUNTER_VALUE(v, fmt, scale) \
+    ((v) >= 0 ? g_strdup_printf(fmt, (scale) * (v)) : g_strdup(_(unk)))
+    gchar *ipc = COUNTER_VALUE(b->bvalue.ipc, "%.2f", 1);
+    gchar *mpki = COUNTER_VALUE(b->bvalue.mpki, "%.2f", 1);
+    gchar *cmiss = COUNTER_VALUE(b->bvalue.cache_miss_rate, "%.1f%%", 100);
+    gchar *brmiss = COUNTER_VALUE(b->bvalue.branch_miss_rate, "%.2f%%", 100);
+    gchar *stallfe = COUNTER_VALUE(b->bvalue.stalled_frontend, "%.1f%%", 100);
+    gchar *stallbe = COUNTER_VALUE(b->bvalue.stalled_backend, "%.1f%%", 100);
+#undef COUNTER_VALUE
+
+    ret = g_strdup_printf("[%s]\n"
+                          /* ipc */ "%s=%s\n"
+                          /* mpki */ "%s=%s\n"
+                          /* cmiss */ "%s=%s\n"
+                          /* brmiss */ "%s=%s\n"
+                          /* stallfe */ "%s=%s\n"
+                          /* stallbe */ "%s=%s\n",
+                          _("Hardware Counters"),
+                          _("Instructions per Cycle"), ipc,
+                          _("Cache Misses per 1K Instructions"), mpki,
+                          _("Cache Miss Rate"), cmiss,
+                          _("Branch Miss Rate"), brmiss,
+                          _("Stalled Cycles (Frontend)"), stallfe,
+                          _("Stalled Cycles (Backend)"), stallbe);
+    g_free(ipc);
+    g_free(mpki);
+    g_free(cmiss);
+    g_free(brmiss);
+    g_free(stallfe);
+    g_free(stallbe);
+    return ret;
+}
+
+static gchar *bench_result_kib_str(int kib)
+{
+    if (kib >= 1024 * 1024 && kib % (1024 * 1024) == 0)
+        return g_strdup_printf("%d %s", kib / (1024 * 1024), _("GiB"));
+    if (kib >= 1024 && kib % 1024 == 0)
+        return g_strdup_printf("%d %s", kib / 1024, _("MiB"));
+    return g_strdup_printf("%d %s", kib, _("KiB"));
+}
+
+/* Cache/Memory latency ladder with the detected levels, next to the
+ * bandwidth at the same size from extra (GB/s from 4 bytes up, doubling) */
+static char *bench_result_latency_section(bench_result *b)
+{
+    gchar **bw, *ret, *size;
+    int i, l, n_bw;
+
+    if (b->bvalue.latency_steps < 1)
+        return g_strdup("");
+
+    ret = g_strdup_printf("[%s]\n", _("Memory Latency"));
+    for (l = 0; l < b->bvalue.cache_levels; l++) {
+        int kib = b->bvalue.cache_level_kib[l];
+        size = bench_result_kib_str(kib);
+        for (i = 0; i < b->bvalue.latency_steps && (1 << i) < kib; i++);
+        ret = h_strdup_cprintf("%s L%d=%s, %.2f %s\n", ret, _("Cache"), l + 1, size,
+                               b->bvalue.latency[MIN(i, b->bvalue.latency_steps - 1)], _("ns"));
+        g_free(size);
+    }
+    ret = h_strdup_cprintf("%s=%.2f %s\n", ret, _("Memory"),
+                           b->bvalue.latency[b->bvalue.latency_steps - 1], _("ns"));
+
+    bw = g_strsplit(b->bvalue.extra, " ", 0);
+    n_bw = g_strv_length(bw);
+    for (i = 0; i < b->bvalue.latency_steps; i++) {
+        gchar *level = NULL;
+        for (l = 0; l < b->bvalue.cache_levels; l++)
+            if (b->bvalue.cache_level_kib[l] == 1 << i)
+                level = g_strdup_printf(" (%s L%d)", _("end of"), l + 1);
+        size = bench_result_kib_str(1 << i);
+        /* extra[k] is the bandwidth at 4 << k bytes, 1 KiB is k = 8 */
+        if (i + 8 < n_bw)
+            ret = h_strdup_cprintf("%s=%.2f %s, %s %s%s\n", ret, size, b->bvalue.latency[i],
+                                   _("ns"), bw[i + 8], _("GB/s"), level ? level : "");
+        else
+            ret = h_strdup_cprintf("%s=%.2f %s%s\n", ret, size, b->bvalue.latency[i],
+                                   _("ns"), level ? level : "");
+        g_free(size);
+        g_free(level);
+    }
+    g_strfreev(bw);
+    return ret;
+}
+
+/* NUMA matrix, a row per cpu node, a column per memory node */
+static char *bench_result_numa_section(bench_result *b)
+{
+    int n = b->bvalue.numa_nodes, from, to, m;
+    gchar *ret = g_strdup(""), *header = NULL;
+
+    if (n < 1)
+        return ret;
+
+    for (to = 0; to < n; to++)
+        header = appf(header, " ", "%7d", b->bvalue.numa_id[to]);
+    for (m = 0; m < 2; m++) {
+        float (*v)[BENCH_MAX_NUMA] = m ? b->bvalue.numa_bandwidth : b->bvalue.numa_latency;
+        ret = h_strdup_cprintf("[%s]\n%s=%s\n", ret,
+                               m ? _("NUMA Bandwidth (GB/s)") : _("NUMA Latency (ns)"),
+                               _("Memory Node"), header);
+        for (from = 0; from < n; from++) {
+            gchar *row = NULL;
+            for (to = 0; to < n; to++)
+                row = (v[from][to] < 0) ? appf(row, " ", "%7s", "-")
+                                        : appf(row, " ", "%7.1f", v[from][to]);
+            ret = h_strdup_cprintf("%s %d=%s\n", ret, _("CPU Node"), b->bvalue.numa_id[from], row);
+            g_free(row);
+        }
+    }
+    g_free(header);
+    return ret;
+}
+
+/* Storage R/W Speed by test */
+static char *bench_result_storage_section(bench_result *b)
+{
+    static const char *tests[BENCH_STORAGE_TESTS] = {
+        N_("Sequential Read 1M QD1"), N_("Sequential Write 1M QD1"),
+        N_("Random Read 4K QD1"), N_("Random Read 4K QD4"), N_("Random Read 4K QD32"),
+        N_("Random Write 4K QD1"), N_("Random Write 4K QD4"), N_("Random Write 4K QD32") };
+    gchar *ret;
+    int t;
+
+    if (b->bvalue.storage_tests < 1)
+        return g_strdup("");
+
+    ret = g_strdup_printf("[%s]\n", _("Storage (p50 / p99 / p99.9 latency)"));
+    for (t = 0; t < b->bvalue.storage_tests; t++) {
+        if (b->bvalue.storage_iops[t] < 0) {
+            ret = h_strdup_cprintf("%s=-\n", ret, _(tests[t]));
+            continue;
+        }
+        ret = h_strdup_cprintf("%s=%.2f %s, %.0f %s, %.1f / %.1f / %.1f %s\n", ret, _(tests[t]),
+                               b->bvalue.storage_mbs[t], _("MB/s"),
+                               b->bvalue.storage_iops[t], _("IOPS"),
+                               b->bvalue.storage_lat[t][0], b->bvalue.storage_lat[t][1],
+                               b->bvalue.storage_lat[t][2], _("us"));
+    }
+    return ret;
+}
+
+/* Internal Network Speed by test, and the round trips */
+static char *bench_result_network_section(bench_result *b)
+{
+    static const char *tests[BENCH_NET_TESTS] = {
+        N_("TCP"), N_("TCP"), N_("UDP"), N_("Unix Socket"), N_("TCP MSG_ZEROCOPY"),
+        N_("TCP sendfile"), N_("TCP splice") };
+    static const char *rtts[BENCH_NET_RTTS] = {
+        N_("TCP Round Trip"), N_("UDP Round Trip"), N_("Unix Socket Round Trip") };
+    gchar *ret;
+    int t, streams;
+
+    if (b->bvalue.net_tests < 1)
+        return g_strdup("");
+
+    ret = g_strdup_printf("[%s]\n", _("Internal Network"));
+    for (t = 0; t < b->bvalue.net_tests; t++) {
+        streams = (t == BENCH_NET_TCP) ? 1 : b->bvalue.net_streams;
+        if (b->bvalue.net_gbits[t] < 0)
+            ret = h_strdup_cprintf("%s x%d=-\n", ret, _(tests[t]), streams);
+        else if (t == BENCH_NET_UDP_STREAMS)
+            ret = h_strdup_cprintf("%s x%d=%.2f %s, %.1f%% %s\n", ret, _(tests[t]), streams,
+                                   b->bvalue.net_gbits[t], _("Gbit/s"),
+                                   b->bvalue.net_udp_loss, _("loss"));
+        else
+            ret = h_strdup_cprintf("%s x%d=%.2f %s\n", ret, _(tests[t]), streams,
+                                   b->bvalue.net_gbits[t], _("Gbit/s"));
+    }
+
+    ret = h_strdup_cprintf("[%s]\n", ret, _("Internal Network (p50 / p99 / p99.9 latency)"));
+    for (t = 0; t < BENCH_NET_RTTS; t++)
+        ret = (b->bvalue.net_rtt[t][0] < 0)
+            ? h_strdup_cprintf("%s=-\n", ret, _(rtts[t]))
+            : h_strdup_cprintf("%s=%.1f / %.1f / %.1f %s\n", ret, _(rtts[t]),
+                               b->bvalue.net_rtt[t][0], b->bvalue.net_rtt[t][1],
+                               b->bvalue.net_rtt[t][2], _("us"));
+    return ret;
+}
+
+/* CryptoHash SHA-1/SHA-256 by code path, and the best of each */
+static char *bench_result_hash_section(bench_result *b)
+{
+    static const char *hashes[BENCH_HASHES] = { N_("SHA-1"), N_("SHA-256") };
+    gchar *ret;
+    int p, h, best;
+
+    if (b->bvalue.hash_paths < 1)
+        return g_strdup("");
+
+    ret = g_strdup_printf("[%s]\n", _("Hash Code Paths (MB/s)"));
+    for (p = 0; p < b->bvalue.hash_paths; p++) {
+        gchar *row = NULL;
+        for (h = 0; h < BENCH_HASHES; h++)
+            row = (b->bvalue.hash_mbs[h][p] < 0)
+                ? appf(row, ", ", "%s -", _(hashes[h]))
+                : appf(row, ", ", "%s %.0f", _(hashes[h]), b->bvalue.hash_mbs[h][p]);
+        ret = h_strdup_cprintf("%s=%s\n", ret, bench_hash_path_name(p), row);
+        g_free(row);
+    }
+    for (h = 0; h < BENCH_HASHES; h++) {
+        best = bench_hash_best_path(&b->bvalue, h);
+        if (b->bvalue.hash_mbs[h][best] > 0 && b->bvalue.hash_mbs[h][BENCH_HASH_SCALAR] > 0)
+            ret = h_strdup_cprintf("%s %s=%s, %.1fx %s\n", ret, _("Best"), _(hashes[h]),
+                                   bench_hash_path_name(best),
+                                   b->bvalue.hash_mbs[h][best] / b->bvalue.hash_mbs[h][BENCH_HASH_SCALAR],
+                                   _("scalar"));
+    }
+    return ret;
+}
+
+/* FPU GEMM by precision, one and all threads, against the peak */
+static char *bench_result_gemm_section(bench_result *b)
+{
+    static const char *precs[BENCH_GEMM_PRECISIONS] = { N_("FP64"), N_("FP32") };
+    static const char *runs[2] = { N_("Single Thread"), N_("All Threads") };
+    gchar *ret;
+    int p, t;
+
+    if (b->bvalue.gemm < 1)
+        return g_strdup("");
+
+    ret = g_strdup_printf("[%s]\n", _("FPU GEMM (GFLOPS)"));
+    for (p = 0; p < BENCH_GEMM_PRECISIONS; p++)
+        for (t = 0; t < 2; t++) {
+            if (b->bvalue.gemm_gflops[p][t] < 0)
+                ret = h_strdup_cprintf("%s %s=-\n", ret, _(precs[p]), _(runs[t]));
+            else if (b->bvalue.gemm_peak[p][t] > 0)
+                ret = h_strdup_cprintf("%s %s=%.1f, %.0f%% %s %.1f\n", ret, _(precs[p]), _(runs[t]),
+                                       b->bvalue.gemm_gflops[p][t],
+                                       100 * b->bvalue.gemm_gflops[p][t] / b->bvalue.gemm_peak[p][t],
+                                       _("of peak"), b->bvalue.gemm_peak[p][t]);
+            else
+                ret = h_strdup_cprintf("%s %s=%.1f\n", ret, _(precs[p]), _(runs[t]),
+                                       b->bvalue.gemm_gflops[p][t]);
+        }
+    return ret;
+}
+
+/* synchronization primitives by thread count, throughput then fairness */
+static char *bench_result_sync_section(bench_result *b)
+{
+    static const char *tests[BENCH_SYNC_TESTS] = {
+        N_("Shared Atomic"), N_("Padded Atomic"), N_("GMutex"),
+        N_("Mutex"), N_("RW Lock"), N_("Ticket Lock") };
+    int n = b->bvalue.sweep_steps, step, test, table;
+    gchar *ret = g_strdup(""), *header = NULL;
+
+    if (b->bvalue.sync_tests < 1 || n < 1)
+        return ret;
+
+    for (step = 0; step < n; step++)
+        header = appf(header, " ", "%7d", b->bvalue.sweep_threads[step]);
+    for (table = 0; table < 2; table++) {
+        ret = h_strdup_cprintf("[%s]\n%s=%s\n", ret,
+                               table ? _("Synchronization Fairness (min/max)")
+                                     : _("Synchronization (Mops/s)"),
+                               _("Threads"), header);
+        for (test = 0; test < BENCH_SYNC_TESTS; test++) {
+            gchar *row = NULL;
+            for (step = 0; step < n; step++) {
+                float v = table ? b->bvalue.sync_fair[test][step] : b->bvalue.sync_mops[test][step];
+                row = (v < 0) ? appf(row, " ", "%7s", "-")
+                              : appf(row, " ", table ? "%7.2f" : "%7.1f", v);
+            }
+            ret = h_strdup_cprintf("%s=%s\n", ret, _(tests[test]), row);
+            g_free(row);
+        }
+    }
+    g_free(header);
+    return ret;
+}
+
+/* allocator patterns, one and all threads, RSS growth */
+static char *bench_result_alloc_section(bench_result *b)
+{
+    static const char *tests[BENCH_ALLOC_TESTS] = {
+        N_("Small Churn"), N_("Cross-thread Free"), N_("Mixed Sizes") };
+    gchar *ret;
+    int t;
+
+    if (b->bvalue.alloc_tests < 1)
+        return g_strdup("");
+
+    ret = g_strdup_printf("[%s]\n", _("Memory Allocator (Mops/s)"));
+    for (t = 0; t < BENCH_ALLOC_TESTS; t++)
+        ret = h_strdup_cprintf("%s=%s %.2f, %s %.2f, %s +%.1f/+%.1f MiB\n", ret, _(tests[t]),
+                               _("1 thread"), b->bvalue.alloc_mops[t][0],
+                               _("all threads"), b->bvalue.alloc_mops[t][1],
+                               _("RSS peak/held"), b->bvalue.alloc_rss[t][0], b->bvalue.alloc_rss[t][1]);
+    return ret;
+}
+
+/* energy over the run, all trials if repeated */
+static char *bench_result_energy_section(bench_result *b)
+{
+    gchar *ret, *per_watt;
+
+    if (b->bvalue.power_w <= 0)
+        return g_strdup("");
+
+    per_watt = (b->bvalue.score_per_watt >= 0)
+        ? g_strdup_printf("%.3f", b->bvalue.score_per_watt)
+        : g_strdup(_(unk));
+    ret = g_strdup_printf("[%s]\n"
+                          /* energy */ "%s=%.1f %s\n"
+                          /* power */ "%s=%.1f %s\n"
+                          /* per watt */ "%s=%s\n"
+                          /* source */ "%s=%s\n",
+                          _("Energy"),
+                          _("Energy"), b->bvalue.energy_j, _("J"),
+                          _("Average Power"), b->bvalue.power_w, _("W"),
+                          _("Score per Watt"), per_watt,
+                          _("Source"), b->bvalue.power_source);
+    g_free(per_watt);
+    return ret;
+}
+
+/* --bench-isolate: how quiet the cpus were */
+static char *bench_result_isolation_section(bench_result *b)
+{
+    gchar *ret, *noise;
+
+    if (b->bvalue.isolated_cpus < 1)
+        return g_strdup("");
+
+    noise = (b->bvalue.noise >= 0)
+        ? g_strdup_printf("%.1f%%%s", b->bvalue.noise,
+                          b->bvalue.noise > BENCH_NOISE_WARN ? problem_marker() : "")
+        : g_strdup(_(unk));
+    ret = g_strdup_printf("[%s]\n"
+                          /* cpus */ "%s=%d\n"
+                          /* noise */ "%s=%s\n"
+                          /* load */ "%s=%.2f\n"
+                          /* nivcsw */ "%s=%d\n",
+                          _("Isolation"),
+                          _("CPUs"), b->bvalue.isolated_cpus,
+                          _("Background Load"), noise,
+                          _("Load Average"), b->bvalue.load_avg,
+                          _("Involuntary Context Switches"), b->bvalue.nivcsw);
+    g_free(noise);
+    return ret;
+}
+
+/* clocks and temperature held during the run */
+static char *bench_result_telemetry_section(bench_result *b)
+{
+    gchar *ret, *mhz, *temp;
+
+    if (b->bvalue.telemetry < 1)
+        return g_strdup("");
+
+    mhz = (b->bvalue.freq_mhz[1] > 0)
+        ? g_strdup_printf("%.0f / %.0f / %.0f %s", b->bvalue.freq_mhz[0], b->bvalue.freq_mhz[1],
+                          b->bvalue.freq_mhz[2], _("MHz"))
+        : g_strdup(_(unk));
+    temp = (b->bvalue.temp_peak > 0)
+        ? g_strdup_printf("%.1f %s", b->bvalue.temp_peak, "\302\260C")
+        : g_strdup(_(unk));
+    ret = g_strdup_printf("[%s]\n"
+                          /* mhz */ "%s=%s\n"
+                          /* temp */ "%s=%s\n"
+                          /* throttled */ "%s=%s\n",
+                          _("Clocks and Temperature"),
+                          _("Clock min/avg/max"), mhz,
+                          _("Peak Temperature"), temp,
+                          _("Throttled"), b->bvalue.throttled ? _("Yes") : _("No"));
+    g_free(mhz);
+    g_free(temp);
+    return ret;
+}
+
+/* core to core medians, and the matrix by core or by CCX */
+static char *bench_result_c2c_section(bench_result *b)
+{
+    static const char *kinds[BENCH_C2C_KINDS] = {
+        N_("SMT Siblings"), N_("Same CCX"), N_("Cross CCX"), N_("Cross Socket") };
+    int n = b->bvalue.c2c_units, from, to, k;
+    gboolean by_core;
+    gchar *ret, *header = NULL;
+
+    if (n < 1)
+        return g_strdup("");
+
+    ret = g_strdup_printf("[%s]\n", _("Core to Core Latency"));
+    for (k = 0; k < BENCH_C2C_KINDS; k++)
+        ret = (b->bvalue.c2c_kind[k] < 0)
+            ? h_strdup_cprintf("%s=-\n", ret, _(kinds[k]))
+            : h_strdup_cprintf("%s=%.1f %s\n", ret, _(kinds[k]), b->bvalue.c2c_kind[k], _("ns"));
+
+    by_core = (b->bvalue.c2c_unit_cpu[0] >= 0);
+    for (to = 0; to < n; to++)
+        header = appf(header, " ", "%7d", by_core ? b->bvalue.c2c_unit_cpu[to]
+                                                  : b->bvalue.c2c_unit_group[to]);
+    ret = h_strdup_cprintf("[%s]\n%s=%s\n", ret, _("Core to Core Latency (ns)"),
+                           by_core ? _("CPU") : _("CCX"), header);
+    for (from = 0; from < n; from++) {
+        gchar *row = NULL;
+        for (to = 0; to < n; to++)
+            row = (b->bvalue.c2c_latency[from][to] < 0)
+                ? appf(row, " ", "%7s", "-")
+                : appf(row, " ", "%7.1f", b->bvalue.c2c_latency[from][to]);
+        if (by_core)
+            ret = h_strdup_cprintf("%s %d (%s%d %s%d)=%s\n", ret, _("CPU"),
+                                   b->bvalue.c2c_unit_cpu[from], _("S"),
+                                   b->bvalue.c2c_unit_socket[from], _("CCX"),
+                                   b->bvalue.c2c_unit_group[from], row);
+        else
+            ret = h_strdup_cprintf("%s %d (%s%d)=%s\n", ret, _("CCX"),
+                                   b->bvalue.c2c_unit_group[from], _("S"),
+                                   b->bvalue.c2c_unit_socket[from], row);
+        g_free(row);
+    }
+    g_free(header);
+    return ret;
+}
+
+static char *bench_result_sections(bench_result *b)
+{
+    gchar *stats = bench_result_stats_section(b);
+    gchar *throughput = bench_result_throughput_section(b);
+    gchar *scaling = bench_result_scaling_section(b);
+    gchar *classes = bench_result_classes_section(b);
+    gchar *counters = bench_result_counters_section(b);
+    gchar *energy = bench_result_energy_section(b);
+    gchar *telemetry = bench_result_telemetry_section(b);
+    gchar *isolation = bench_result_isolation_section(b);
+    gchar *latency = bench_result_latency_section(b);
+    gchar *numa = bench_result_numa_section(b);
+    gchar *c2c = bench_result_c2c_section(b);
+    gchar *storage = bench_result_storage_section(b);
+    gchar *network = bench_result_network_section(b);
+    gchar *hash = bench_result_hash_section(b);
+    gchar *gemm = bench_result_gemm_section(b);
+    gchar *sync = bench_result_sync_section(b);
+    gchar *alloc = bench_result_alloc_section(b);
+    gchar *ret = g_strconcat(stats, throughput, scaling, classes, counters, energy,
+                             telemetry, isolation, latency, numa, c2c, storage,
+                             network, hash, gemm, sync, alloc, NULL);
+
+    g_free(stats);
+    g_free(throughput);
+    g_free(scaling);
+    g_free(classes);
+    g_free(counters);
+    g_free(energy);
+    g_free(telemetry);
+    g_free(isolation);
+    g_free(latency);
+    g_free(numa);
+    g_free(c2c);
+    g_free(storage);
+    g_free(network);
+    g_free(hash);
+    g_free(gemm);
+    g_free(sync);
+    g_free(alloc);
+    return ret;
+}
+
 static char *bench_result_more_info_less(bench_result *b)
 {
     char *memory = NULL;
@@ -402,6 +1245,7 @@ static char *bench_result_more_info_less(bench_result *b)
     char bits[24] = "";
     if (b->machine->ptr_bits)
         snprintf(bits, 23, _("%d-bit"), b->machine->ptr_bits);
+    char *stats = bench_result_sections(b);
 
     char *ret = g_strdup_printf(
         "[%s]\n"
@@ -410,6 +1254,7 @@ static char *bench_result_more_info_less(bench_result *b)
         "%s=%s\n"
         "%s=%s\n"
         /* legacy */ "%s%s=%s\n"
+        /* stats */ "%s"
         "[%s]\n"
         /* board */ "%s=%s\n"
         /* machine_type */ "%s=%s\n"
@@ -432,6 +1277,7 @@ static char *bench_result_more_info_less(bench_result *b)
                       "might not be comparable to current version. Some "
                       "details are missing.")
                   : "",
+        stats,
         _("Machine"),
         _("Board"), (b->machine->board != NULL) ? b->machine->board : _(unk),
         _("Machine Type"), (b->machine->machine_type != NULL) ? b->machine->machine_type : _(unk),
@@ -445,6 +1291,7 @@ static char *bench_result_more_info_less(bench_result *b)
         _("Memory"), memory,
         b->machine->ptr_bits ? _("Pointer Size") : "#AddySize", bits);
     g_free(memory);
+    g_free(stats);
     return ret;
 }
 
@@ -458,8 +1305,9 @@ static char *bench_result_more_info_complete(bench_result *b)
     char bits[24] = "";
     if (b->machine->ptr_bits)
         snprintf(bits, 23, _("%d-bit"), b->machine->ptr_bits);
+    char *stats = bench_result_sections(b);
 
-    return g_strdup_printf(
+    char *ret = g_strdup_printf(
         "[%s]\n"
         /* bench name */ "%s=%s\n"
         /* threads */ "%s=%d\n"
@@ -467,6 +1315,7 @@ static char *bench_result_more_info_complete(bench_result *b)
         /* elapsed */ "%s=%0.4f %s\n"
         "%s=%s\n"
         /* legacy */ "%s%s=%s\n"
+        /* stats */ "%s"
         "[%s]\n"
         /* board */ "%s=%s\n"
         /* machine_type */ "%s=%s\n"
@@ -497,6 +1346,7 @@ static char *bench_result_more_info_complete(bench_result *b)
                       "might not be comparable to current version. Some "
                       "details are missing.")
                   : "",
+        stats,
         _("Machine"), _("Board"),
         (b->machine->board != NULL) ? b->machine->board : _(unk),
         _("Machine Type"), (b->machine->machine_type != NULL) ? b->machine->machine_type : _(unk),
@@ -518,6 +1368,8 @@ static char *bench_result_more_info_complete(bench_result *b)
         ".machine_data_version", b->machine->machine_data_version,
         ".is_su_data", b->machine->is_su_data, _("Handles"), _("mid"),
         b->machine->mid, _("cfg_val"), cpu_config_val(b->machine->cpu_config));
+    g_free(stats);
+    return ret;
 }
 
 char *bench_result_more_info(bench_result *b)
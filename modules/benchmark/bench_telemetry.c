@@ -0,0 +1,261 @@
+/*
+ *    hardinfo2 - System Information and Benchmark
+ *    Copyright (C) 2026 hardinfo2 project
+ *    License: GPL2+
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License v2.0 or later.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/* Clocks and temperatures held during a benchmark run.
+ *
+ * A sampler thread wakes every TELEMETRY_MSEC, reads scaling_cur_freq with
+ * cpufreq_update() and the temperatures of the cpu hwmon chips (coretemp,
+ * k10temp, zenpower, *cpu*, *soc*), found the way modules/devices/sensors.c
+ * does. It sleeps otherwise, so it takes a few hundred sysfs reads per
+ * second from the run at most.
+ *
+ * Clocks are read on the cpus the workers of the run are pinned to, once
+ * it started a job on the pool, before that and for benchmarks that do not
+ * use the pool on every cpu the process may run on (the --bench-isolate
+ * fence); parked cores outside the run would only pull the average down.
+ * Kept are min/avg/max MHz over those cpus and the samples, and the peak
+ * temperature. A run is flagged as throttled if the thermal_throttle
+ * counters of any allowed cpu went up (x86), or if a sensor reached its
+ * crit limit (or raised its crit alarm) while the average clock of the
+ * sample fell more than TELEMETRY_DROP below the best one of the run.
+ * tempN_max is only a warning threshold, the chip does not slow down
+ * there. Idle cores clock down in the serial parts of a benchmark, so a
+ * low min alone does not mean throttling. */
+
+#define _GNU_SOURCE
+#include <sched.h>
+#include <string.h>
+
+#include "hardinfo.h"
+#include "cpu_util.h"
+#include "benchmark.h"
+
+#define TELEMETRY_MSEC 200
+#define TELEMETRY_MAX_TEMPS 32
+#define TELEMETRY_DROP 0.10
+
+struct bench_telemetry {
+    GThread *thread;
+    gint stop;
+    gint n_cpus;
+    gint *cpus;                          /* allowed, by id */
+    guint jobs;                          /* of the pool at the start */
+    cpufreq_data *cpufreq[CPU_SETSIZE];  /* by id, when first sampled */
+    gint n_temps;
+    gchar *temp_path[TELEMETRY_MAX_TEMPS];
+    gchar *alarm_path[TELEMETRY_MAX_TEMPS]; /* tempN_crit_alarm, or NULL */
+    gint temp_crit[TELEMETRY_MAX_TEMPS];  /* millidegrees, 0 if none */
+    guint64 throttle_start;
+    /* by the sampler */
+    gint samples;
+    gint khz_min, khz_max;
+    double khz_sum;
+    gint n_khz;
+    double khz_best;                     /* best average of a sample */
+    gint temp_peak;                      /* millidegrees */
+    gboolean temp_throttled;
+};
+
+static gint telemetry_read(const gchar *path, gint null_val)
+{
+    gchar *buf = NULL;
+    gint ret = null_val;
+
+    if (g_file_get_contents(path, &buf, NULL, NULL)) {
+        ret = atoi(buf);
+        g_free(buf);
+    }
+    return ret;
+}
+
+static void telemetry_temps(bench_telemetry *t)
+{
+    static const char *prefix[] = { "device/", "", NULL };
+    gchar *path, *tmp, *name;
+    const gchar *file;
+    gint hwmon, p, id, limit;
+    GDir *dir;
+
+    for (hwmon = 0; t->n_temps < TELEMETRY_MAX_TEMPS; hwmon++) {
+        path = g_strdup_printf("/sys/class/hwmon/hwmon%d", hwmon);
+        if (!g_file_test(path, G_FILE_TEST_EXISTS)) {
+            g_free(path);
+            break;
+        }
+        tmp = g_strdup_printf("%s/name", path);
+        name = NULL;
+        g_file_get_contents(tmp, &name, NULL, NULL);
+        g_free(tmp);
+        if (!name || !bench_hwmon_cpu_chip(name)) {
+            g_free(name);
+            g_free(path);
+            continue;
+        }
+        g_free(name);
+
+        for (p = 0; prefix[p]; p++) {
+            tmp = g_strdup_printf("%s/%s", path, prefix[p]);
+            dir = g_dir_open(tmp, 0, NULL);
+            g_free(tmp);
+            if (!dir) continue;
+            while ((file = g_dir_read_name(dir)) && t->n_temps < TELEMETRY_MAX_TEMPS) {
+                if (!g_str_has_prefix(file, "temp") || !g_str_has_suffix(file, "_input") ||
+                    sscanf(file, "temp%d", &id) != 1)
+                    continue;
+                tmp = g_strdup_printf("%s/%stemp%d_crit", path, prefix[p], id);
+                limit = telemetry_read(tmp, 0);
+                g_free(tmp);
+                tmp = g_strdup_printf("%s/%stemp%d_crit_alarm", path, prefix[p], id);
+                if (!g_file_test(tmp, G_FILE_TEST_EXISTS)) {
+                    g_free(tmp);
+                    tmp = NULL;
+                }
+                t->alarm_path[t->n_temps] = tmp;
+                t->temp_path[t->n_temps] = g_strdup_printf("%s/%s%s", path, prefix[p], file);
+                t->temp_crit[t->n_temps++] = MAX(limit, 0);
+            }
+            g_dir_close(dir);
+        }
+        g_free(path);
+    }
+}
+
+static guint64 telemetry_throttle_count(bench_telemetry *t)
+{
+    guint64 count = 0;
+    gint i;
+
+    for (i = 0; i < t->n_cpus; i++)
+        count += get_cpu_int("thermal_throttle/core_throttle_count", t->cpus[i], 0) +
+                 get_cpu_int("thermal_throttle/package_throttle_count", t->cpus[i], 0);
+    return count;
+}
+
+static void telemetry_sample(bench_telemetry *t)
+{
+    gint cpus[CPU_SETSIZE], n = 0, i, khz, temp, n_khz = 0;
+    gboolean crit = FALSE;
+    double khz_sum = 0;
+    cpufreq_data *cf;
+
+    if (bench_workers_jobs() != t->jobs)
+        n = bench_workers_active_cpus(cpus, CPU_SETSIZE);
+    if (n == 0) {
+        memcpy(cpus, t->cpus, t->n_cpus * sizeof(gint));
+        n = t->n_cpus;
+    }
+
+    for (i = 0; i < n; i++) {
+        if (cpus[i] < 0 || cpus[i] >= CPU_SETSIZE)
+            continue;
+        if (!(cf = t->cpufreq[cpus[i]]))
+            cf = t->cpufreq[cpus[i]] = cpufreq_new(cpus[i]);
+        cpufreq_update(cf, 1);
+        if ((khz = cf->cpukhz_cur) <= 0)
+            continue;
+        t->khz_min = t->n_khz ? MIN(t->khz_min, khz) : khz;
+        t->khz_max = MAX(t->khz_max, khz);
+        khz_sum += khz;
+        n_khz++;
+    }
+    t->khz_sum += khz_sum;
+    t->n_khz += n_khz;
+    for (i = 0; i < t->n_temps; i++) {
+        temp = telemetry_read(t->temp_path[i], 0);
+        t->temp_peak = MAX(t->temp_peak, temp);
+        if ((t->temp_crit[i] > 0 && temp >= t->temp_crit[i]) ||
+            (t->alarm_path[i] && telemetry_read(t->alarm_path[i], 0) > 0))
+            crit = TRUE;
+    }
+    if (n_khz > 0) {
+        /* hot and slower than before: the chip is holding its clocks down */
+        if (crit && khz_sum / n_khz < t->khz_best * (1 - TELEMETRY_DROP))
+            t->temp_throttled = TRUE;
+        t->khz_best = MAX(t->khz_best, khz_sum / n_khz);
+    }
+    t->samples++;
+}
+
+static gpointer telemetry_main(gpointer data)
+{
+    bench_telemetry *t = (bench_telemetry *)data;
+    gint msec;
+
+    while (!g_atomic_int_get(&t->stop)) {
+        telemetry_sample(t);
+        for (msec = 0; msec < TELEMETRY_MSEC && !g_atomic_int_get(&t->stop); msec += 10)
+            g_usleep(10000);
+    }
+    return NULL;
+}
+
+bench_telemetry *bench_telemetry_start(void)
+{
+    bench_telemetry *t = g_new0(bench_telemetry, 1);
+    cpu_set_t allowed;
+    gint i;
+
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+        CPU_SET(0, &allowed);
+    t->cpus = g_new0(gint, CPU_COUNT(&allowed));
+    for (i = 0; i < CPU_SETSIZE; i++)
+        if (CPU_ISSET(i, &allowed))
+            t->cpus[t->n_cpus++] = i;
+    t->jobs = bench_workers_jobs();
+    telemetry_temps(t);
+    t->throttle_start = telemetry_throttle_count(t);
+
+#if GLIB_CHECK_VERSION(2,32,0)
+    t->thread = g_thread_new("bench-telemetry", telemetry_main, t);
+#else
+    t->thread = g_thread_create(telemetry_main, t, TRUE, NULL);
+#endif
+    return t;
+}
+
+void bench_telemetry_stop(bench_telemetry *t, bench_value *r)
+{
+    gint i;
+
+    if (!t) return;
+    g_atomic_int_set(&t->stop, 1);
+    if (t->thread)
+        g_thread_join(t->thread);
+    else
+        telemetry_sample(t); /* no thread, one sample at the end */
+
+    if (t->n_khz > 0 || t->temp_peak > 0) {
+        r->telemetry = t->samples;
+        r->freq_mhz[0] = t->n_khz ? t->khz_min / 1000.0 : -1;
+        r->freq_mhz[1] = t->n_khz ? t->khz_sum / t->n_khz / 1000.0 : -1;
+        r->freq_mhz[2] = t->n_khz ? t->khz_max / 1000.0 : -1;
+        r->temp_peak = t->temp_peak > 0 ? t->temp_peak / 1000.0 : -1;
+        r->throttled = t->temp_throttled || telemetry_throttle_count(t) > t->throttle_start;
+    }
+
+    for (i = 0; i < CPU_SETSIZE; i++)
+        if (t->cpufreq[i])
+            cpufreq_free(t->cpufreq[i]);
+    g_free(t->cpus);
+    for (i = 0; i < t->n_temps; i++) {
+        g_free(t->temp_path[i]);
+        g_free(t->alarm_path[i]);
+    }
+    g_free(t);
+}
@@ -1,5 +1,10 @@
 
+#include <math.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
 #include "benchmark.h"
+#include "cpu_util.h"
 #include "md5.h"
 
 gchar *get_test_data(gsize min_size) {
@@ -59,3 +64,226 @@ char *md5_digest_str(const char *data, unsigned int len) {
     MD5Final(digest, &ctx);
     return digest_to_str((char *)digest, 16);
 }
+
+/* two-sided 95% t-distribution values, index is degrees of freedom */
+static const double t95[] = {
+    0.0, 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+
+static double t95_dof(int dof) {
+    return (dof < (int)G_N_ELEMENTS(t95)) ? t95[dof] : 1.96;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double A = *(const double *)a, B = *(const double *)b;
+    return (A > B) - (A < B);
+}
+
+void bench_value_stats(bench_value *r) {
+    double sorted[BENCH_MAX_TRIALS], sum = 0, var = 0, mean;
+    int i, n = MIN(r->trials, BENCH_MAX_TRIALS);
+
+    if (n < 1) return;
+
+    memcpy(sorted, r->trial, n * sizeof(double));
+    qsort(sorted, n, sizeof(double), cmp_double);
+    r->min = sorted[0];
+    r->max = sorted[n - 1];
+    r->median = (n & 1) ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+
+    for (i = 0; i < n; i++) sum += sorted[i];
+    mean = sum / n;
+    for (i = 0; i < n; i++) var += (sorted[i] - mean) * (sorted[i] - mean);
+
+    r->stddev = (n > 1) ? sqrt(var / (n - 1)) : 0;
+    r->ci95 = (n > 1) ? t95_dof(n - 1) * r->stddev / sqrt(n) : 0;
+}
+
+/* 95% confidence interval of the mean relative to the mean, -1 if there
+ * are less than two values or the mean is not positive */
+double bench_rel_ci95(const double *v, int n) {
+    double sum = 0, var = 0, mean;
+    int i;
+
+    if (n < 2) return -1;
+    for (i = 0; i < n; i++) sum += v[i];
+    mean = sum / n;
+    if (mean <= 0) return -1;
+    for (i = 0; i < n; i++) var += (v[i] - mean) * (v[i] - mean);
+    return t95_dof(n - 1) * sqrt(var / (n - 1)) / sqrt(n) / mean;
+}
+
+gint64 bench_time_usec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (gint64)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+gint64 bench_time_nsec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (gint64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* random cyclic chain of cache lines over buf, same seed every time;
+ * neither the prefetchers nor out of order execution can follow it */
+#define CHASE_LINE 64
+
+void **bench_chase_chain(gchar *buf, gsize size)
+{
+    gsize n = size / CHASE_LINE, i, j;
+    guint32 *order = g_new(guint32, n);
+    guint64 x = 0x9e3779b97f4a7c15ULL;
+    void **start;
+
+    for (i = 0; i < n; i++) order[i] = i;
+    for (i = n - 1; i > 0; i--) {
+        guint32 t;
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        j = x % (i + 1);
+        t = order[i]; order[i] = order[j]; order[j] = t;
+    }
+    for (i = 0; i < n; i++)
+        *(void **)(buf + (gsize)order[i] * CHASE_LINE) = buf + (gsize)order[(i + 1) % n] * CHASE_LINE;
+    start = (void **)(buf + (gsize)order[0] * CHASE_LINE);
+    g_free(order);
+
+    return start;
+}
+
+/* ns per dependent load along the chain, over at least 20 ms */
+double bench_chase_ns(void **p)
+{
+    unsigned long long count = 1 << 12, k;
+    gint64 usec = 0, start;
+
+    while (count <= (1ULL << 40)) {
+        start = bench_time_usec();
+        for (k = 0; k < count; k += 8) {
+            p = *p; p = *p; p = *p; p = *p;
+            p = *p; p = *p; p = *p; p = *p;
+        }
+        usec = bench_time_usec() - start;
+        if (usec > 20000) break;
+        count <<= 1;
+    }
+    /* keep the chain live */
+    if (p == NULL) return -1;
+
+    return usec * 1000.0 / count;
+}
+
+gsize bench_llc_bytes(void)
+{
+    int i, level, max_level = 0;
+    gsize llc = 0;
+
+    for (i = 0; i < 8; i++) {
+        gchar *path = g_strdup_printf("cache/index%d/level", i);
+        level = get_cpu_int(path, 0, 0);
+        g_free(path);
+        if (!level) break;
+        if (level > max_level) {
+            max_level = level;
+            path = g_strdup_printf("cache/index%d/size", i);
+            llc = get_cpu_int(path, 0, 0) * 1024L; /* "32768K" */
+            g_free(path);
+        }
+    }
+    return llc;
+}
+
+/* hwmon chip of the cpu, by its name file */
+gboolean bench_hwmon_cpu_chip(const gchar *name)
+{
+    return g_str_has_prefix(name, "coretemp") || g_str_has_prefix(name, "k10temp") ||
+           g_str_has_prefix(name, "zenpower") || strstr(name, "cpu") || strstr(name, "soc");
+}
+
+#define BENCH_HUGE_PAGE (2 * 1024 * 1024) /* if the kernel does not say */
+
+/* default hugetlbfs page size (Hugepagesize of /proc/meminfo), or the
+ * transparent one (PMD size): 2 MiB on x86, but 1 GiB may be the default
+ * there and arm64 with 64K pages has 512 MiB */
+static gsize bench_huge_page(gboolean hugetlb)
+{
+    gchar *buf = NULL, *line;
+    gsize page = 0;
+
+    if (hugetlb) {
+        if (g_file_get_contents("/proc/meminfo", &buf, NULL, NULL) &&
+            (line = strstr(buf, "Hugepagesize:")))
+            page = g_ascii_strtoull(line + strlen("Hugepagesize:"), NULL, 10) * 1024;
+    } else if (g_file_get_contents("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size",
+                                   &buf, NULL, NULL)) {
+        page = g_ascii_strtoull(buf, NULL, 10);
+    }
+    g_free(buf);
+    return page ? page : BENCH_HUGE_PAGE;
+}
+
+/* mapped by the caller and written here, so first touch puts the pages on
+ * the node of the calling thread, which is pinned if it is a worker.
+ * --bench-hugepages thp rounds the copy up to whole aligned transparent
+ * huge pages and asks for them; explicit rounds it up to hugetlbfs pages
+ * and takes them from the pool, falling back to thp when it is empty.
+ * mapped, what bench_local_free() unmaps, is the rounded length */
+gpointer bench_local_copy(gconstpointer data, gsize size, gsize *mapped, gint *kind)
+{
+    const gchar *mode = params.bench_hugepages;
+    gboolean huge = mode && !SEQ(mode, "off");
+    gsize len = size, page;
+    gchar *p = MAP_FAILED, *aligned;
+
+    *kind = BENCH_LOCAL_COPY;
+#ifdef MAP_HUGETLB
+    if (huge && SEQ(mode, "explicit")) {
+        page = bench_huge_page(TRUE);
+        len = (size + page - 1) / page * page;
+        p = mmap(NULL, len, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED)
+            *kind = BENCH_LOCAL_HUGETLB;
+        else
+            DEBUG("no hugetlbfs pages for %" G_GSIZE_FORMAT " bytes, using thp", len);
+    }
+#endif
+    if (p == MAP_FAILED && huge) {
+        page = bench_huge_page(FALSE);
+        len = (size + page - 1) / page * page;
+        /* one huge page more, to trim to a huge page boundary */
+        p = mmap(NULL, len + page, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p != MAP_FAILED) {
+            aligned = (gchar *)(((guintptr)p + page - 1) / page * page);
+            if (aligned > p)
+                munmap(p, aligned - p);
+            munmap(aligned + len, p + page - aligned);
+            p = aligned;
+#ifdef MADV_HUGEPAGE
+            if (madvise(p, len, MADV_HUGEPAGE) == 0)
+                *kind = BENCH_LOCAL_THP;
+#endif
+        }
+    }
+    if (p == MAP_FAILED) {
+        len = size;
+        p = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+    if (p == MAP_FAILED) {
+        *mapped = 0;
+        *kind = BENCH_LOCAL_SHARED;
+        return NULL;
+    }
+
+    memcpy(p, data, size);
+    *mapped = len;
+    return p;
+}
+
+void bench_local_free(gpointer p, gsize mapped)
+{
+    if (p && mapped)
+        munmap(p, mapped);
+}
@@ -0,0 +1,768 @@
+/*
+ *    hardinfo2 - System Information and Benchmark
+ *    Copyright (C) 2026 hardinfo2 project
+ *    License: GPL2+
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License v2.0 or later.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/* Persistent benchmark worker pool.
+ *
+ * Workers are created once, each pinned to one logical cpu, and reused by
+ * benchmark_crunch_for()/benchmark_parallel_for(). Worker N is pinned to the
+ * N-th cpu of a topology ordered list: first one thread of every core (socket
+ * by socket), then the SMT siblings. So a job of "cores" threads gets one
+ * thread per physical core. All workers of a job, and the caller, leave the
+ * start barrier together.
+ *
+ * Hybrid cpus (P/E cores, big.LITTLE) are split in core classes, from the
+ * cpu_core/cpu_atom PMUs, cpu_capacity or cpufreq max frequency clusters.
+ * bench_workers_set_class() limits the list, and so the workers, to one
+ * class; bench_workers_set_node() to the cpus of one NUMA node;
+ * bench_workers_set_cpus() pins worker N to the N-th cpu of a given list.
+ * bench_workers_fence() confines the process to a cpu list, the pool is
+ * then built from those cpus only.
+ *
+ * bench_steal_*() hand out a fixed set of tasks for irregular jobs: every
+ * worker has a deque that starts with a contiguous block of the tasks, takes
+ * from its front and, when empty, steals the back half of the fullest other
+ * deque. A deque is a [front, back) range in one 64 bit word changed only by
+ * compare and swap; task numbers are never reused, so there is no ABA. */
+
+#define _GNU_SOURCE
+#include <sched.h>
+#include <pthread.h>
+
+#include "hardinfo.h"
+#include "cpu_util.h"
+#include "benchmark.h"
+
+typedef struct {
+    GThread *thread;
+    gint index;
+    gint cpu;          /* pinned to logical cpu, -1 for not pinned */
+    gint node;         /* NUMA node of cpu, -1 if not known */
+    guint generation;  /* last job seen */
+    guint pinned;      /* pin generation of cpu */
+    gint pmu_type;     /* hybrid cpus: PMU of the class of cpu, else 0 */
+    bench_counters counts; /* last job, --bench-counters */
+} bench_worker;
+
+typedef struct {
+    gint id, socket_id, core_id, rank;
+    gint class_id;
+    gint node_id;
+} bench_cpu;
+
+typedef struct {
+    gchar name[16];
+    gint64 speed;      /* capacity, kHz or PMU order; larger is faster */
+    gint cores, threads;
+    gint pmu_type;     /* perf event source type, 0 if not by PMU */
+} bench_core_class;
+
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t job_cond;
+    pthread_cond_t done_cond;
+    bench_worker **workers;
+    gint n_workers;
+    bench_cpu *cpus;   /* all allowed, in pinning order */
+    gint n_all;
+    gint *cpu_order;   /* cpus of the current class/node, in pinning order */
+    gint n_cpus;
+    gint n_cores;      /* of cpu_order */
+    bench_core_class classes[BENCH_MAX_CLASSES];
+    gint n_classes;
+    gint class_id;     /* -1 for all */
+    gint node_id;      /* -1 for all */
+    gint *fixed;       /* explicit cpu list, overrides class and node */
+    gint n_fixed;
+    gint fenced;       /* --bench-isolate, cpus counts are of the fence */
+    guint pin_generation;
+    guint generation;
+    gint shutdown;
+    guint jobs;
+    /* current job */
+    gint n_active;
+    gint pending;
+    gint arrived;
+    gint counters;
+    bench_worker_func func;
+    gpointer data;
+} pool = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .job_cond = PTHREAD_COND_INITIALIZER,
+    .done_cond = PTHREAD_COND_INITIALIZER,
+    .class_id = -1,
+    .node_id = -1,
+};
+
+static gint bench_cpu_sort(gconstpointer a, gconstpointer b)
+{
+    const bench_cpu *A = a, *B = b;
+    if (A->rank != B->rank) return A->rank - B->rank;
+    if (A->socket_id != B->socket_id) return A->socket_id - B->socket_id;
+    if (A->core_id != B->core_id) return A->core_id - B->core_id;
+    return A->id - B->id;
+}
+
+/* "0-3,8,10-11" */
+static gboolean bench_cpulist_has(const gchar *list, gint cpu)
+{
+    gchar **ranges = g_strsplit(list, ",", 0);
+    gboolean ret = FALSE;
+    gint i, lo, hi;
+
+    for (i = 0; ranges[i] && !ret; i++) {
+        switch (sscanf(ranges[i], "%d-%d", &lo, &hi)) {
+        case 1: ret = (cpu == lo); break;
+        case 2: ret = (cpu >= lo && cpu <= hi); break;
+        }
+    }
+    g_strfreev(ranges);
+    return ret;
+}
+
+static gint bench_class_sort(gconstpointer a, gconstpointer b)
+{
+    const bench_core_class *A = a, *B = b;
+    return (A->speed < B->speed) - (A->speed > B->speed);
+}
+
+/* classes from the Intel hybrid PMUs, else cpu_capacity (arm), else cpufreq
+ * max frequency clusters more than 10% apart; pool.cpus[].class_id set */
+static void bench_workers_classes(void)
+{
+    static const struct { const gchar *pmu, *name; } pmus[] = {
+        { "cpu_core", "P-core" },
+        { "cpu_atom", "E-core" },
+    };
+    gint64 *speed = g_new0(gint64, pool.n_all);
+    gchar *list[G_N_ELEMENTS(pmus)] = { NULL };
+    gint pmu_type[G_N_ELEMENTS(pmus)] = { 0 };
+    gint i, c, n = 0;
+    gboolean by_pmu = TRUE, by_capacity = TRUE;
+
+    memset(pool.classes, 0, sizeof(pool.classes));
+    for (c = 0; c < (gint)G_N_ELEMENTS(pmus); c++) {
+        gchar *path = g_strdup_printf("/sys/bus/event_source/devices/%s/cpus", pmus[c].pmu);
+        if (!g_file_get_contents(path, &list[c], NULL, NULL))
+            by_pmu = FALSE;
+        g_free(path);
+        if (list[c]) {
+            path = g_strdup_printf("/sys/bus/event_source/devices/%s", pmus[c].pmu);
+            pmu_type[c] = h_sysfs_read_int(path, "type");
+            g_free(path);
+        }
+    }
+
+    for (i = 0; i < pool.n_all; i++) {
+        bench_cpu *cpu = &pool.cpus[i];
+        if (by_pmu) {
+            speed[i] = bench_cpulist_has(list[0], cpu->id) ? 2 : 1;
+            continue;
+        }
+        speed[i] = get_cpu_int("cpu_capacity", cpu->id, -1);
+        if (speed[i] < 0) by_capacity = FALSE;
+    }
+    if (!by_pmu && !by_capacity)
+        for (i = 0; i < pool.n_all; i++)
+            speed[i] = get_cpu_int("cpufreq/cpuinfo_max_freq", pool.cpus[i].id, 0);
+
+    /* group, fastest first */
+    for (i = 0; i < pool.n_all; i++) {
+        for (c = 0; c < n; c++) {
+            if (by_pmu || by_capacity ? speed[i] == pool.classes[c].speed
+                                      : ABS(speed[i] - pool.classes[c].speed) * 10 <= pool.classes[c].speed)
+                break;
+        }
+        if (c == n) {
+            if (n == BENCH_MAX_CLASSES) break;
+            pool.classes[n++].speed = speed[i];
+        }
+    }
+    qsort(pool.classes, n, sizeof(bench_core_class), bench_class_sort);
+
+    for (c = 0; c < n; c++) {
+        bench_core_class *cl = &pool.classes[c];
+        if (by_pmu) {
+            g_strlcpy(cl->name, pmus[cl->speed == 2 ? 0 : 1].name, sizeof(cl->name));
+            cl->pmu_type = pmu_type[cl->speed == 2 ? 0 : 1];
+        } else if (by_capacity)
+            snprintf(cl->name, sizeof(cl->name), "cap %d", (gint)cl->speed);
+        else
+            snprintf(cl->name, sizeof(cl->name), "%d MHz", (gint)(cl->speed / 1000));
+    }
+    for (i = 0; i < pool.n_all; i++) {
+        pool.cpus[i].class_id = -1;
+        for (c = 0; c < n; c++) {
+            if (by_pmu || by_capacity ? speed[i] == pool.classes[c].speed
+                                      : ABS(speed[i] - pool.classes[c].speed) * 10 <= pool.classes[c].speed) {
+                pool.cpus[i].class_id = c;
+                pool.classes[c].threads++;
+                if (pool.cpus[i].rank == 0) pool.classes[c].cores++;
+                break;
+            }
+        }
+    }
+    pool.n_classes = (n > 1) ? n : 0;
+
+    for (c = 0; c < pool.n_classes; c++)
+        DEBUG("benchmark core class %d: %s, %d cores, %d threads", c,
+              pool.classes[c].name, pool.classes[c].cores, pool.classes[c].threads);
+
+    for (c = 0; c < (gint)G_N_ELEMENTS(pmus); c++) g_free(list[c]);
+    g_free(speed);
+}
+
+/* pool.lock held; pinning order of the fixed list, or the current class and node */
+static void bench_workers_use_cpus(void)
+{
+    gint i;
+
+    pool.n_cpus = pool.n_cores = 0;
+    if (pool.n_fixed) {
+        for (i = 0; i < pool.n_fixed && i < pool.n_all; i++)
+            pool.cpu_order[pool.n_cpus++] = pool.fixed[i];
+        pool.n_cores = pool.n_cpus;
+        pool.pin_generation++;
+        return;
+    }
+    for (i = 0; i < pool.n_all; i++) {
+        if (pool.class_id >= 0 && pool.cpus[i].class_id != pool.class_id) continue;
+        if (pool.node_id >= 0 && pool.cpus[i].node_id != pool.node_id) continue;
+        pool.cpu_order[pool.n_cpus++] = pool.cpus[i].id;
+        if (pool.cpus[i].rank == 0) pool.n_cores++;
+    }
+    pool.pin_generation++;
+}
+
+gint bench_online_nodes(gint *nodes, gint max)
+{
+    gchar *list = NULL, **ranges;
+    gint i, lo, hi, n = 0;
+
+    if (!g_file_get_contents("/sys/devices/system/node/online", &list, NULL, NULL))
+        return 0;
+    ranges = g_strsplit(g_strstrip(list), ",", 0);
+    for (i = 0; ranges[i]; i++) {
+        switch (sscanf(ranges[i], "%d-%d", &lo, &hi)) {
+        case 1: hi = lo; break;
+        case 2: break;
+        default: continue;
+        }
+        for (; lo <= hi && n < max; lo++)
+            nodes[n++] = lo;
+    }
+    g_strfreev(ranges);
+    g_free(list);
+    return n;
+}
+
+/* from the cpuN/nodeM link, -1 if not NUMA */
+static gint bench_cpu_node(gint cpu, const gint *nodes, gint n_nodes)
+{
+    gint i;
+
+    for (i = 0; i < n_nodes; i++) {
+        gchar *path = g_strdup_printf("/sys/devices/system/cpu/cpu%d/node%d", cpu, nodes[i]);
+        gboolean found = g_file_test(path, G_FILE_TEST_EXISTS);
+        g_free(path);
+        if (found) return nodes[i];
+    }
+    return -1;
+}
+
+/* allowed cpus, one thread per core first, then siblings */
+static void bench_workers_cpu_order(void)
+{
+    cpu_set_t allowed;
+    bench_cpu *cpus;
+    gint nodes[BENCH_MAX_NODES], n_nodes;
+    gint i, j, n = 0;
+
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+        return;
+
+    n_nodes = bench_online_nodes(nodes, BENCH_MAX_NODES);
+    cpus = g_new0(bench_cpu, CPU_COUNT(&allowed));
+    for (i = 0; i < CPU_SETSIZE && n < CPU_COUNT(&allowed); i++) {
+        if (!CPU_ISSET(i, &allowed)) continue;
+        cpu_topology_data *topo = cputopo_new(i);
+        cpus[n].id = i;
+        cpus[n].socket_id = topo->socket_id;
+        cpus[n].core_id = topo->core_id;
+        cpus[n].node_id = bench_cpu_node(i, nodes, n_nodes);
+        for (j = 0; j < n; j++)
+            if (cpus[j].socket_id == cpus[n].socket_id && cpus[j].core_id == cpus[n].core_id)
+                cpus[n].rank++;
+        cputopo_free(topo);
+        n++;
+    }
+    qsort(cpus, n, sizeof(bench_cpu), bench_cpu_sort);
+
+    pool.cpus = cpus;
+    pool.n_all = n;
+    pool.cpu_order = g_new0(gint, n);
+    bench_workers_classes();
+    bench_workers_use_cpus();
+
+    DEBUG("benchmark workers: %d cpus available for pinning", n);
+}
+
+/* pool.lock held */
+static void bench_workers_pin(bench_worker *w)
+{
+    cpu_set_t set;
+    gint i;
+
+    w->cpu = -1;
+    w->node = -1;
+    w->pmu_type = 0;
+    w->pinned = pool.pin_generation;
+    if (pool.n_cpus == 0) return;
+
+    CPU_ZERO(&set);
+    if (w->index < pool.n_cpus) {
+        CPU_SET(pool.cpu_order[w->index], &set);
+    } else {
+        /* more workers than cpus: float over the class */
+        for (i = 0; i < pool.n_cpus; i++)
+            CPU_SET(pool.cpu_order[i], &set);
+    }
+    if (sched_setaffinity(0, sizeof(set), &set) == 0 && w->index < pool.n_cpus)
+        w->cpu = pool.cpu_order[w->index];
+
+    for (i = 0; i < pool.n_all && w->cpu >= 0; i++)
+        if (pool.cpus[i].id == w->cpu) {
+            w->node = pool.cpus[i].node_id;
+            if (pool.cpus[i].class_id >= 0)
+                w->pmu_type = pool.classes[pool.cpus[i].class_id].pmu_type;
+            break;
+        }
+}
+
+/* the caller and all active workers leave together */
+static void bench_workers_barrier(void)
+{
+    gint total = g_atomic_int_get(&pool.n_active) + 1;
+
+    g_atomic_int_inc(&pool.arrived);
+    while (g_atomic_int_get(&pool.arrived) < total)
+        g_thread_yield();
+}
+
+static gpointer bench_worker_main(gpointer data)
+{
+    bench_worker *w = (bench_worker *)data;
+    gint counters;
+
+    pthread_mutex_lock(&pool.lock);
+    bench_workers_pin(w);
+    DEBUG("benchmark worker %d pinned to cpu %d", w->index, w->cpu);
+
+    while (!pool.shutdown) {
+        if (w->generation == pool.generation || w->index >= pool.n_active) {
+            w->generation = pool.generation;
+            pthread_cond_wait(&pool.job_cond, &pool.lock);
+            continue;
+        }
+        w->generation = pool.generation;
+        if (w->pinned != pool.pin_generation)
+            bench_workers_pin(w);
+        counters = pool.counters;
+        pthread_mutex_unlock(&pool.lock);
+
+        /* opened before the barrier to keep the syscalls out of the run */
+        if (counters) bench_counters_open(&w->counts, w->pmu_type);
+        bench_workers_barrier();
+        if (counters) bench_counters_enable(&w->counts);
+        pool.func(pool.data, w->index);
+        if (counters) bench_counters_close(&w->counts);
+
+        pthread_mutex_lock(&pool.lock);
+        if (--pool.pending == 0)
+            pthread_cond_signal(&pool.done_cond);
+    }
+    pthread_mutex_unlock(&pool.lock);
+
+    return NULL;
+}
+
+/* pool.lock held */
+static void bench_workers_grow(gint n_workers)
+{
+    gint i;
+
+    if (!pool.cpus) bench_workers_cpu_order();
+    if (n_workers <= pool.n_workers) return;
+
+    pool.workers = g_renew(bench_worker *, pool.workers, n_workers);
+    for (i = pool.n_workers; i < n_workers; i++) {
+        bench_worker *w = g_new0(bench_worker, 1);
+        w->index = i;
+        w->cpu = -1;
+        w->node = -1;
+        w->generation = pool.generation;
+#if GLIB_CHECK_VERSION(2,32,0)
+        w->thread = g_thread_new("bench-worker", (GThreadFunc)bench_worker_main, w);
+#else
+        w->thread = g_thread_create((GThreadFunc)bench_worker_main, w, TRUE, NULL);
+#endif
+        pool.workers[i] = w;
+    }
+    pool.n_workers = n_workers;
+}
+
+gint bench_workers_start(gint n_threads, bench_worker_func func, gpointer data)
+{
+    int cpu_procs, cpu_cores, cpu_threads, cpu_nodes;
+
+    if (n_threads < 1) return 0;
+
+    cpu_procs_cores_threads_nodes(&cpu_procs, &cpu_cores, &cpu_threads, &cpu_nodes);
+
+    pthread_mutex_lock(&pool.lock);
+    bench_workers_grow(MAX(n_threads, cpu_threads));
+    pool.jobs++;
+    pool.func = func;
+    pool.data = data;
+    pool.counters = params.bench_counters;
+    pool.n_active = n_threads;
+    pool.pending = n_threads;
+    g_atomic_int_set(&pool.arrived, 0);
+    pool.generation++;
+    pthread_cond_broadcast(&pool.job_cond);
+    pthread_mutex_unlock(&pool.lock);
+
+    bench_workers_barrier();
+
+    return n_threads;
+}
+
+void bench_workers_wait(void)
+{
+    pthread_mutex_lock(&pool.lock);
+    while (pool.pending > 0)
+        pthread_cond_wait(&pool.done_cond, &pool.lock);
+    pthread_mutex_unlock(&pool.lock);
+}
+
+gint bench_workers_cpu(gint thread_number)
+{
+    gint cpu = -1;
+
+    pthread_mutex_lock(&pool.lock);
+    if (thread_number >= 0 && thread_number < pool.n_workers)
+        cpu = pool.workers[thread_number]->cpu;
+    pthread_mutex_unlock(&pool.lock);
+
+    return cpu;
+}
+
+gint bench_workers_node(gint thread_number)
+{
+    gint node = -1;
+
+    pthread_mutex_lock(&pool.lock);
+    if (thread_number >= 0 && thread_number < pool.n_workers)
+        node = pool.workers[thread_number]->node;
+    pthread_mutex_unlock(&pool.lock);
+
+    return node;
+}
+
+gint bench_workers_active_cpus(gint *cpus, gint max)
+{
+    gint i, n = 0;
+
+    pthread_mutex_lock(&pool.lock);
+    for (i = 0; i < pool.n_active && i < pool.n_workers && n < max; i++)
+        if (pool.workers[i]->cpu >= 0)
+            cpus[n++] = pool.workers[i]->cpu;
+    pthread_mutex_unlock(&pool.lock);
+
+    return n;
+}
+
+guint bench_workers_jobs(void)
+{
+    guint jobs;
+
+    pthread_mutex_lock(&pool.lock);
+    jobs = pool.jobs;
+    pthread_mutex_unlock(&pool.lock);
+
+    return jobs;
+}
+
+gint bench_core_classes(void)
+{
+    gint n;
+
+    pthread_mutex_lock(&pool.lock);
+    if (!pool.cpus) bench_workers_cpu_order();
+    n = pool.n_classes;
+    pthread_mutex_unlock(&pool.lock);
+
+    return n;
+}
+
+const gchar *bench_core_class_name(gint class_id)
+{
+    const gchar *name = NULL;
+
+    pthread_mutex_lock(&pool.lock);
+    if (!pool.cpus) bench_workers_cpu_order();
+    if (class_id >= 0 && class_id < pool.n_classes)
+        name = pool.classes[class_id].name;
+    pthread_mutex_unlock(&pool.lock);
+
+    return name;
+}
+
+void bench_workers_set_class(gint class_id)
+{
+    pthread_mutex_lock(&pool.lock);
+    if (!pool.cpus) bench_workers_cpu_order();
+    if (pool.cpus) {
+        pool.class_id = (class_id >= 0 && class_id < pool.n_classes) ? class_id : -1;
+        bench_workers_use_cpus();
+    }
+    pthread_mutex_unlock(&pool.lock);
+}
+
+gint bench_workers_set_node(gint node_id)
+{
+    gint n = 0;
+
+    pthread_mutex_lock(&pool.lock);
+    if (!pool.cpus) bench_workers_cpu_order();
+    if (pool.cpus) {
+        pool.node_id = node_id;
+        bench_workers_use_cpus();
+        n = pool.n_cpus;
+    }
+    pthread_mutex_unlock(&pool.lock);
+
+    return n;
+}
+
+gboolean bench_workers_counters(bench_counters *sum)
+{
+    gint i;
+
+    memset(sum, 0, sizeof(*sum));
+    pthread_mutex_lock(&pool.lock);
+    if (!pool.counters || pool.pending > 0) {
+        pthread_mutex_unlock(&pool.lock);
+        return FALSE;
+    }
+    for (i = 0; i < pool.n_active && i < pool.n_workers; i++)
+        bench_counters_add(sum, &pool.workers[i]->counts, i == 0);
+    pthread_mutex_unlock(&pool.lock);
+
+    return TRUE;
+}
+
+gint bench_workers_set_cpus(const gint *cpus, gint n_cpus)
+{
+    gint n = 0;
+
+    pthread_mutex_lock(&pool.lock);
+    if (!pool.cpus) bench_workers_cpu_order();
+    if (pool.cpus) {
+        g_free(pool.fixed);
+        pool.fixed = NULL;
+        pool.n_fixed = MAX(n_cpus, 0);
+        if (pool.n_fixed) {
+            pool.fixed = g_new(gint, pool.n_fixed);
+            memcpy(pool.fixed, cpus, pool.n_fixed * sizeof(gint));
+        }
+        bench_workers_use_cpus();
+        n = pool.n_cpus;
+    }
+    pthread_mutex_unlock(&pool.lock);
+
+    return n;
+}
+
+gint bench_workers_fence(const gchar *list)
+{
+    cpu_set_t allowed, set;
+    gint i, n = 0;
+
+    CPU_ZERO(&allowed);
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+        return 0;
+    for (i = 0; i < CPU_SETSIZE; i++)
+        if (CPU_ISSET(i, &allowed) && bench_cpulist_has(list, i)) {
+            CPU_SET(i, &set);
+            n++;
+        }
+    /* this thread, and so every thread created after it */
+    if (n == 0 || sched_setaffinity(0, sizeof(set), &set) != 0)
+        return 0;
+
+    pthread_mutex_lock(&pool.lock);
+    if (pool.cpus) {
+        /* built before, workers repin on their next job */
+        g_free(pool.cpus);
+        g_free(pool.cpu_order);
+        pool.cpus = NULL;
+    }
+    bench_workers_cpu_order();
+    pool.fenced = TRUE;
+    pthread_mutex_unlock(&pool.lock);
+
+    DEBUG("benchmark fenced to %d cpus: %s", n, list);
+    return n;
+}
+
+void bench_workers_cores_threads(gint *cores, gint *threads)
+{
+    int cpu_procs, cpu_nodes;
+
+    pthread_mutex_lock(&pool.lock);
+    if (pool.class_id >= 0 || pool.node_id >= 0 || pool.n_fixed || pool.fenced) {
+        *cores = pool.n_cores;
+        *threads = pool.n_cpus;
+        pthread_mutex_unlock(&pool.lock);
+        return;
+    }
+    pthread_mutex_unlock(&pool.lock);
+
+    cpu_procs_cores_threads_nodes(&cpu_procs, cores, threads, &cpu_nodes);
+}
+
+/* one cache line (or two) per deque */
+typedef struct {
+    guint64 range; /* front << 32 | back */
+    gchar pad[120];
+} bench_steal_deque;
+
+struct bench_steal {
+    gint n_queues;
+    guint steals;
+    bench_steal_deque *queues;
+};
+
+#define STEAL_RANGE(front, back) (((guint64)(front) << 32) | (guint32)(back))
+#define STEAL_FRONT(range) ((guint32)((range) >> 32))
+#define STEAL_BACK(range) ((guint32)(range))
+
+bench_steal *bench_steal_new(gint n_queues, guint n_tasks)
+{
+    bench_steal *s = g_new0(bench_steal, 1);
+    gint q;
+
+    s->n_queues = MAX(n_queues, 1);
+    s->queues = g_new0(bench_steal_deque, s->n_queues);
+    for (q = 0; q < s->n_queues; q++)
+        s->queues[q].range = STEAL_RANGE((guint64)n_tasks * q / s->n_queues,
+                                         (guint64)n_tasks * (q + 1) / s->n_queues);
+    return s;
+}
+
+gboolean bench_steal_next(bench_steal *s, gint queue, guint *task)
+{
+    bench_steal_deque *own = &s->queues[queue];
+    guint64 range, want;
+    guint32 front, back, left, best_left;
+    gint q, best;
+
+    /* own front */
+    range = __atomic_load_n(&own->range, __ATOMIC_ACQUIRE);
+    while (STEAL_FRONT(range) < STEAL_BACK(range)) {
+        want = STEAL_RANGE(STEAL_FRONT(range) + 1, STEAL_BACK(range));
+        if (__atomic_compare_exchange_n(&own->range, &range, want, FALSE,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            *task = STEAL_FRONT(range);
+            return TRUE;
+        }
+    }
+
+    /* own deque is empty, so only thieves that found work look at it */
+    for (;;) {
+        best = -1;
+        best_left = 0;
+        for (q = 0; q < s->n_queues; q++) {
+            range = __atomic_load_n(&s->queues[q].range, __ATOMIC_ACQUIRE);
+            left = STEAL_BACK(range) - STEAL_FRONT(range);
+            if (q != queue && STEAL_FRONT(range) < STEAL_BACK(range) && left > best_left) {
+                best = q;
+                best_left = left;
+            }
+        }
+        if (best < 0)
+            return FALSE;
+
+        range = __atomic_load_n(&s->queues[best].range, __ATOMIC_ACQUIRE);
+        front = STEAL_FRONT(range);
+        back = STEAL_BACK(range);
+        if (front >= back)
+            continue;
+        left = back - (back - front + 1) / 2; /* new back of the victim */
+        if (!__atomic_compare_exchange_n(&s->queues[best].range, &range,
+                                         STEAL_RANGE(front, left), FALSE,
+                                         __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            continue;
+        __atomic_store_n(&own->range, STEAL_RANGE(left + 1, back), __ATOMIC_RELEASE);
+        __atomic_add_fetch(&s->steals, 1, __ATOMIC_RELAXED);
+        *task = left;
+        return TRUE;
+    }
+}
+
+guint bench_steal_count(bench_steal *s)
+{
+    return __atomic_load_n(&s->steals, __ATOMIC_RELAXED);
+}
+
+void bench_steal_free(bench_steal *s)
+{
+    if (!s) return;
+    g_free(s->queues);
+    g_free(s);
+}
+
+void bench_workers_free(void)
+{
+    gint i;
+
+    pthread_mutex_lock(&pool.lock);
+    pool.shutdown = 1;
+    pthread_cond_broadcast(&pool.job_cond);
+    pthread_mutex_unlock(&pool.lock);
+
+    for (i = 0; i < pool.n_workers; i++) {
+        g_thread_join(pool.workers[i]->thread);
+        g_free(pool.workers[i]);
+    }
+    g_free(pool.workers);
+    g_free(pool.cpu_order);
+    g_free(pool.cpus);
+    g_free(pool.fixed);
+
+    pool.workers = NULL;
+    pool.fixed = NULL;
+    pool.n_fixed = 0;
+    pool.cpu_order = NULL;
+    pool.cpus = NULL;
+    pool.n_workers = pool.n_cpus = pool.n_all = pool.n_classes = 0;
+    pool.class_id = pool.node_id = -1;
+    pool.shutdown = 0;
+}
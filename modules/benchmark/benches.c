@@ -35,6 +35,7 @@ void SN(gboolean reload) { \
     static gboolean scanned=FALSE; \
     if(params.aborting_benchmarks) return; \
     if(reload || bench_results[BID].result<=0.0) scanned = FALSE; \
+    else scanned = TRUE; /* e.g. from a batch run */ \
     if(reload){DEBUG("BENCH SCAN RELOAD %s\n",BN);} else if(scanned) {DEBUG("BENCH SCAN OK %s\n",BN);}else{DEBUG("BENCH SCAN %s\n",BN);} \
     if(scanned) return; \
     if(!(entries[BID].flags & MODULE_FLAG_NO_REMOTE) || params.gui_running || params.run_benchmark) \
@@ -56,7 +57,7 @@ BENCH_SIMPLE(BENCHMARK_BLOWFISH_THREADS, "CPU Blowfish (Multi-thread)", benchmar
 BENCH_SIMPLE(BENCHMARK_BLOWFISH_CORES, "CPU Blowfish (Multi-core)", benchmark_bfish_cores, 1);
 BENCH_SIMPLE(BENCHMARK_ZLIB, "CPU Zlib", benchmark_zlib, 1);
 BENCH_SIMPLE(BENCHMARK_CRYPTOHASH, "CPU CryptoHash", benchmark_cryptohash, 1);
-BENCH_SIMPLE(BENCHMARK_IPERF3_SINGLE, "Internal Network Speed", benchmark_iperf3_single, 1);
+BENCH_SIMPLE(BENCHMARK_NETWORK, "Internal Network Speed", benchmark_network, 1);
 #if(HARDINFO2_QT5)
 BENCH_SIMPLE(BENCHMARK_OPENGL, "GPU OpenGL Drawing", benchmark_opengl, 1);
 #endif
@@ -75,6 +76,13 @@ BENCH_SIMPLE(BENCHMARK_MEMORY_QUAD, "SysBench Memory (Quad threads)", benchmark_
 BENCH_SIMPLE(BENCHMARK_MEMORY_ALL, "SysBench Memory (Multi-thread)", benchmark_memory_all, 1);
 BENCH_SIMPLE(BENCHMARK_STORAGE, "Storage R/W Speed", benchmark_storage, 1);
 BENCH_SIMPLE(BENCHMARK_CACHEMEM, "Cache/Memory", benchmark_cachemem, 1);
+BENCH_SIMPLE(BENCHMARK_STREAM, "Memory Bandwidth (Multi-thread)", benchmark_stream, 1);
+BENCH_SIMPLE(BENCHMARK_NUMA, "Memory NUMA Matrix", benchmark_numa, 1);
+BENCH_SIMPLE(BENCHMARK_C2C, "CPU Core to Core Latency", benchmark_c2c, 0);
+BENCH_SIMPLE(BENCHMARK_GEMM, "FPU GEMM", benchmark_gemm, 1);
+BENCH_SIMPLE(BENCHMARK_RAYTRACE_MT, "FPU Raytracing (Multi-thread)", benchmark_raytrace_mt, 1);
+BENCH_SIMPLE(BENCHMARK_SYNC, "CPU Synchronization", benchmark_sync, 1);
+BENCH_SIMPLE(BENCHMARK_ALLOC, "Memory Allocator", benchmark_alloc, 1);
 
 BENCH_CALLBACK(callback_benchmark_gui, "GPU Drawing", BENCHMARK_GUI, 1);
 void scan_benchmark_gui(gboolean reload)
@@ -82,6 +90,7 @@ void scan_benchmark_gui(gboolean reload)
     static gboolean scanned=FALSE;
     if(params.aborting_benchmarks) return;
     if (reload || bench_results[BENCHMARK_GUI].result<=0.0) scanned = FALSE;
+    else scanned = TRUE;
     if (scanned) return;
 
     bench_value er = EMPTY_BENCH_VALUE;
@@ -130,6 +139,13 @@ static char *entries_english_name[] = {
 #endif
 	    ,"Storage R/W Speed"
 	    ,"Cache/Memory"
+	    ,"Memory Bandwidth (Multi-thread)"
+	    ,"Memory NUMA Matrix"
+	    ,"CPU Core to Core Latency"
+	    ,"FPU GEMM"
+	    ,"FPU Raytracing (Multi-thread)"
+	    ,"CPU Synchronization"
+	    ,"Memory Allocator"
 };
 
 //Note: Same order as entries
@@ -138,9 +154,9 @@ static int entries_btimer[] = {
     7,//"CPU Blowfish (Multi-thread)",
     7,//"CPU Blowfish (Multi-core)",
     7,//"CPU Zlib",
-    5,//"CPU CryptoHash",
+    8,//"CPU CryptoHash",
     5,//"CPU Fibonacci",
-    5,//"CPU N-Queens",
+    8,//"CPU N-Queens",
     5,//"FPU FFT",
     5,//"FPU Raytracing (Single-thread)",
     10,//"Internal Network Speed",
@@ -161,8 +177,15 @@ static int entries_btimer[] = {
 #if(HARDINFO2_VK)
     3,//,"GPU Vulkan Drawing"
 #endif
-    4,//,"Storage R/W Speed"
-    5,//,"Cache/Memory"
+    7,//,"Storage R/W Speed"
+    7,//,"Cache/Memory"
+    5,//,"Memory Bandwidth (Multi-thread)"
+    6,//,"Memory NUMA Matrix"
+    10,//,"CPU Core to Core Latency"
+    5,//,"FPU GEMM"
+    7,//,"FPU Raytracing (Multi-thread)"
+    8,//,"CPU Synchronization"
+    5,//,"Memory Allocator"
 };
 
 
@@ -239,12 +262,12 @@ static ModuleEntry entries[] = {
             scan_benchmark_raytrace,
             MODULE_FLAG_BENCHMARK,
         },
-    [BENCHMARK_IPERF3_SINGLE] =
+    [BENCHMARK_NETWORK] =
         {
             N_("Internal Network Speed"),
             "network.svg",
-            callback_benchmark_iperf3_single,
-            scan_benchmark_iperf3_single,
+            callback_benchmark_network,
+            scan_benchmark_network,
             MODULE_FLAG_BENCHMARK,
         },
     [BENCHMARK_SBCPU_SINGLE] =
@@ -357,8 +380,70 @@ static ModuleEntry entries[] = {
             scan_benchmark_cachemem,
             MODULE_FLAG_BENCHMARK,
         },
+    [BENCHMARK_STREAM] =
+        {
+            N_("Memory Bandwidth (Multi-thread)"),
+            "memory.svg",
+            callback_benchmark_stream,
+            scan_benchmark_stream,
+            MODULE_FLAG_BENCHMARK,
+        },
+    [BENCHMARK_NUMA] =
+        {
+            N_("Memory NUMA Matrix"),
+            "memory.svg",
+            callback_benchmark_numa,
+            scan_benchmark_numa,
+            MODULE_FLAG_BENCHMARK,
+        },
+    [BENCHMARK_C2C] =
+        {
+            N_("CPU Core to Core Latency"),
+            "processor.svg",
+            callback_benchmark_c2c,
+            scan_benchmark_c2c,
+            MODULE_FLAG_BENCHMARK,
+        },
+    [BENCHMARK_GEMM] =
+        {
+            N_("FPU GEMM"),
+            "fft.svg",
+            callback_benchmark_gemm,
+            scan_benchmark_gemm,
+            MODULE_FLAG_BENCHMARK,
+        },
+    [BENCHMARK_RAYTRACE_MT] =
+        {
+            N_("FPU Raytracing (Multi-thread)"),
+            "raytrace.svg",
+            callback_benchmark_raytrace_mt,
+            scan_benchmark_raytrace_mt,
+            MODULE_FLAG_BENCHMARK,
+        },
+    [BENCHMARK_SYNC] =
+        {
+            N_("CPU Synchronization"),
+            "processor.svg",
+            callback_benchmark_sync,
+            scan_benchmark_sync,
+            MODULE_FLAG_BENCHMARK,
+        },
+    [BENCHMARK_ALLOC] =
+        {
+            N_("Memory Allocator"),
+            "memory.svg",
+            callback_benchmark_alloc,
+            scan_benchmark_alloc,
+            MODULE_FLAG_BENCHMARK,
+        },
     {NULL}};
 
+/* R = 0 in BENCH_SIMPLE() above */
+static gboolean benchmark_lower_is_better(gint entry)
+{
+    return entry == BENCHMARK_C2C;
+}
+
 const gchar *hi_note_func(gint entry)
 {
     switch (entry) {
@@ -371,7 +456,21 @@ const gchar *hi_note_func(gint entry)
     case BENCHMARK_MEMORY_QUAD:
     case BENCHMARK_MEMORY_ALL:
         return _("Results in MiB/second. Higher is better.");
-    case BENCHMARK_IPERF3_SINGLE:
+    case BENCHMARK_STREAM:
+        return _("Results in MB/s (STREAM Triad). Higher is better.");
+    case BENCHMARK_NUMA:
+        return _("Results in MB/s, average of all node pairs. Higher is better.");
+    case BENCHMARK_C2C:
+        return _("Results in ns, median of all core pairs. Lower is better.");
+    case BENCHMARK_GEMM:
+        return _("Results in GFLOPS (FP64, all threads). Higher is better.");
+    case BENCHMARK_RAYTRACE_MT:
+        return _("Results in Mrays/s (all threads). Higher is better.");
+    case BENCHMARK_SYNC:
+        return _("Results in Mops/s, geometric mean of the primitives (all threads). Higher is better.");
+    case BENCHMARK_ALLOC:
+        return _("Results in Mops/s (malloc+free), geometric mean of the patterns (all threads). Higher is better.");
+    case BENCHMARK_NETWORK:
         return _("Results in Gbits/s. Higher is better.");
     case BENCHMARK_CRYPTOHASH:
     case BENCHMARK_BLOWFISH_SINGLE:
@@ -64,7 +64,7 @@ void benchmark_bfish_do(int threads, int entry, const char *status)
     gchar *d = md5_digest_str(test_data, BENCH_DATA_SIZE);
     //if (!SEQ(d, BENCH_DATA_MD5))
 
-    r = benchmark_crunch_for(CRUNCH_TIME, threads, bfish_exec, test_data);
+    r = benchmark_crunch_for_local(CRUNCH_TIME, threads, bfish_exec, test_data, BENCH_DATA_SIZE);
     r.result /= 100;
     r.revision = BENCH_REVISION;
     snprintf(r.extra, 255, "%0.1fs, k:%s, d:%s", (double)CRUNCH_TIME, k, d);
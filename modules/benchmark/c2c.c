@@ -0,0 +1,338 @@
+/*
+ *    hardinfo2 - System Information and Benchmark
+ *    Copyright (C) 2026 hardinfo2 project
+ *    License: GPL2+
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License v2.0 or later.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/* Core to core latency.
+ *
+ * Two workers, pinned with bench_workers_set_cpus(), bounce a counter in one
+ * cache line: the first writes odd values and waits for the next even one,
+ * the second the other way round. One way latency is half a round trip,
+ * median of C2C_BATCHES batches. Every pair of cores (first thread of each)
+ * is measured, and every core with its SMT siblings.
+ *
+ * cpus are grouped by socket (cputopo_new()) and by the cpus sharing the last
+ * level cache: a CCX on AMD, usually the whole socket on Intel. Pairs are
+ * SMT siblings, same CCX, cross CCX (same socket) or cross socket; the
+ * medians of each are kept. The matrix is by core up to BENCH_MAX_C2C cores,
+ * else by CCX, with the median of the pairs between two CCXs. Result is the
+ * median of all pairs of cores, in ns. */
+
+#define _GNU_SOURCE
+#include <sched.h>
+#include <stdlib.h>
+
+#include "hardinfo.h"
+#include "cpu_util.h"
+#include "benchmark.h"
+
+/* if anything changes in this block, increment revision */
+#define BENCH_REVISION 1
+#define C2C_ROUNDS 1000
+#define C2C_BATCHES 5
+#define C2C_LINE 128    /* two lines, for the adjacent line prefetcher */
+#define C2C_SPINS 65536 /* then yield, the pair may share a cpu */
+#define C2C_MAX_SECONDS 30
+
+typedef struct {
+    gint id, socket_id, core_id, rank;
+    gint group; /* socket and last level cache */
+} c2c_cpu;
+
+typedef struct {
+    gint a, b; /* index in cpus */
+    gint kind;
+    float ns;
+} c2c_pair;
+
+typedef struct {
+    gint *flag;
+} c2c_data;
+
+static int c2c_float_cmp(const void *a, const void *b)
+{
+    float A = *(const float *)a, B = *(const float *)b;
+    return (A > B) - (A < B);
+}
+
+static float c2c_median(float *v, gint n)
+{
+    if (n < 1) return -1;
+    qsort(v, n, sizeof(float), c2c_float_cmp);
+    return (n % 2) ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2;
+}
+
+static void c2c_wait(gint *flag, gint value)
+{
+    guint spins = 0;
+
+    while (g_atomic_int_get(flag) != value)
+        if (++spins % C2C_SPINS == 0)
+            g_thread_yield();
+}
+
+/* thread 0 returns the one way ns */
+static gpointer c2c_pingpong(unsigned int start, unsigned int end, void *data, gint thread_number)
+{
+    c2c_data *d = (c2c_data *)data;
+    float batch[C2C_BATCHES + 1];
+    double *ns;
+    gint64 t0;
+    gint b, k, v = 0;
+
+    if (thread_number) {
+        for (k = 0; k < (C2C_BATCHES + 1) * C2C_ROUNDS; k++) {
+            c2c_wait(d->flag, 2 * k + 1);
+            g_atomic_int_set(d->flag, 2 * k + 2);
+        }
+        return NULL;
+    }
+
+    /* the first batch warms up */
+    for (b = 0; b <= C2C_BATCHES; b++) {
+        t0 = bench_time_usec();
+        for (k = 0; k < C2C_ROUNDS; k++, v += 2) {
+            g_atomic_int_set(d->flag, v + 1);
+            c2c_wait(d->flag, v + 2);
+        }
+        batch[b] = (bench_time_usec() - t0) * 1000.0 / (2 * C2C_ROUNDS);
+    }
+
+    ns = g_new(double, 1);
+    *ns = c2c_median(batch + 1, C2C_BATCHES);
+    return ns;
+}
+
+/* shared_cpu_list of the highest level cache */
+static gchar *c2c_llc_list(gint cpu)
+{
+    gint i, level, max_level = 0;
+    gchar *path, *list = NULL;
+
+    for (i = 0; i < 8; i++) {
+        path = g_strdup_printf("cache/index%d/level", i);
+        level = get_cpu_int(path, cpu, 0);
+        g_free(path);
+        if (!level) break;
+        if (level > max_level) {
+            max_level = level;
+            g_free(list);
+            path = g_strdup_printf("cache/index%d/shared_cpu_list", i);
+            list = get_cpu_str(path, cpu);
+            g_free(path);
+        }
+    }
+    return list ? g_strstrip(list) : NULL;
+}
+
+static gint c2c_cpu_sort(gconstpointer a, gconstpointer b)
+{
+    const c2c_cpu *A = a, *B = b;
+    if (A->group != B->group) return A->group - B->group;
+    if (A->core_id != B->core_id) return A->core_id - B->core_id;
+    return A->id - B->id;
+}
+
+static gint c2c_socket_sort(gconstpointer a, gconstpointer b)
+{
+    const c2c_cpu *A = a, *B = b;
+    if (A->socket_id != B->socket_id) return A->socket_id - B->socket_id;
+    return A->id - B->id;
+}
+
+/* allowed cpus by group, core; groups numbered socket by socket */
+static c2c_cpu *c2c_topology(gint *n_cpus, gint *n_groups)
+{
+    GPtrArray *keys = g_ptr_array_new_with_free_func(g_free);
+    gchar **llc;
+    cpu_set_t allowed;
+    c2c_cpu *cpus;
+    gint i, j, n = 0;
+
+    *n_cpus = *n_groups = 0;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+        return NULL;
+
+    cpus = g_new0(c2c_cpu, CPU_COUNT(&allowed));
+    for (i = 0; i < CPU_SETSIZE && n < CPU_COUNT(&allowed); i++) {
+        if (!CPU_ISSET(i, &allowed)) continue;
+        cpu_topology_data *topo = cputopo_new(i);
+        cpus[n].id = i;
+        cpus[n].socket_id = topo->socket_id;
+        cpus[n].core_id = topo->core_id;
+        cputopo_free(topo);
+        n++;
+    }
+    qsort(cpus, n, sizeof(c2c_cpu), c2c_socket_sort);
+
+    llc = g_new0(gchar *, n + 1);
+    for (i = 0; i < n; i++) {
+        gchar *list = c2c_llc_list(cpus[i].id);
+        llc[i] = g_strdup_printf("%d:%s", cpus[i].socket_id, list ? list : "");
+        g_free(list);
+        for (j = 0; j < (gint)keys->len; j++)
+            if (SEQ(llc[i], g_ptr_array_index(keys, j))) break;
+        if (j == (gint)keys->len)
+            g_ptr_array_add(keys, g_strdup(llc[i]));
+        cpus[i].group = j;
+        for (j = 0; j < i; j++)
+            if (cpus[j].socket_id == cpus[i].socket_id && cpus[j].core_id == cpus[i].core_id)
+                cpus[i].rank++;
+    }
+    qsort(cpus, n, sizeof(c2c_cpu), c2c_cpu_sort);
+
+    *n_cpus = n;
+    *n_groups = keys->len;
+    g_strfreev(llc);
+    g_ptr_array_free(keys, TRUE);
+    return cpus;
+}
+
+static float c2c_measure(c2c_data *d, gint cpu_a, gint cpu_b)
+{
+    gint pair[2] = { cpu_a, cpu_b };
+    bench_value v;
+
+    if (bench_workers_set_cpus(pair, 2) < 2)
+        return -1;
+    g_atomic_int_set(d->flag, 0);
+    v = benchmark_parallel(2, c2c_pingpong, d);
+    if (bench_workers_cpu(0) != cpu_a || bench_workers_cpu(1) != cpu_b)
+        return -1;
+    return v.result;
+}
+
+void benchmark_c2c(void)
+{
+    bench_value r = EMPTY_BENCH_VALUE;
+    c2c_cpu *cpus;
+    c2c_pair *pairs;
+    c2c_data d;
+    gchar *line;
+    gint n_cpus, n_groups, n_cores = 0, n_sockets = 0, n_pairs = 0, skipped = 0, n, i, j, k;
+    gint *unit, by_core;
+    float *v;
+    GTimer *timer;
+
+    shell_view_set_enabled(FALSE);
+    shell_status_update("Measuring core to core latency...");
+
+    cpus = c2c_topology(&n_cpus, &n_groups);
+    for (i = 0; i < n_cpus; i++) {
+        if (cpus[i].rank == 0) n_cores++;
+        if (i == 0 || cpus[i].socket_id != cpus[i - 1].socket_id) n_sockets++;
+    }
+    if (n_cpus < 2) {
+        g_free(cpus);
+        r.result = -1;
+        snprintf(r.extra, sizeof(r.extra), "needs two cpus");
+        goto out;
+    }
+
+    line = g_malloc0(3 * C2C_LINE);
+    d.flag = (gint *)(((gsize)line + C2C_LINE - 1) & ~(gsize)(C2C_LINE - 1));
+    pairs = g_new0(c2c_pair, n_cpus * (n_cpus - 1) / 2);
+
+    timer = g_timer_new();
+    for (i = 0; i < n_cpus; i++) {
+        for (j = i + 1; j < n_cpus; j++) {
+            c2c_pair *p = &pairs[n_pairs];
+            gboolean smt = cpus[i].socket_id == cpus[j].socket_id &&
+                           cpus[i].core_id == cpus[j].core_id;
+
+            if (!smt && (cpus[i].rank || cpus[j].rank)) continue;
+            if (g_timer_elapsed(timer, NULL) > C2C_MAX_SECONDS) {
+                skipped++;
+                continue;
+            }
+            p->a = i;
+            p->b = j;
+            p->kind = smt ? BENCH_C2C_SMT
+                    : cpus[i].group == cpus[j].group ? BENCH_C2C_CCX
+                    : cpus[i].socket_id == cpus[j].socket_id ? BENCH_C2C_CROSS_CCX
+                    : BENCH_C2C_SOCKET;
+            p->ns = c2c_measure(&d, cpus[i].id, cpus[j].id);
+            if (p->ns > 0) n_pairs++;
+        }
+    }
+    bench_workers_set_cpus(NULL, 0);
+    r.elapsed_time = g_timer_elapsed(timer, NULL);
+    g_timer_destroy(timer);
+    g_free(line);
+
+    /* medians by kind; all pairs of cores for the result */
+    v = g_new(float, MAX(n_pairs, 1));
+    for (k = 0; k < BENCH_C2C_KINDS; k++) {
+        for (i = n = 0; i < n_pairs; i++)
+            if (pairs[i].kind == k) v[n++] = pairs[i].ns;
+        r.c2c_kind[k] = c2c_median(v, n);
+    }
+    for (i = n = 0; i < n_pairs; i++)
+        if (pairs[i].kind != BENCH_C2C_SMT) v[n++] = pairs[i].ns;
+    r.result = c2c_median(v, n);
+    if (n == 0) /* one core, SMT only */
+        r.result = r.c2c_kind[BENCH_C2C_SMT];
+
+    /* matrix units: the cores, or the groups if there are too many */
+    by_core = (n_cores <= BENCH_MAX_C2C);
+    r.c2c_units = by_core ? n_cores : MIN(n_groups, BENCH_MAX_C2C);
+    unit = g_new(gint, n_cpus);
+    for (i = 0, n = -1; i < n_cpus; i++) {
+        if (!by_core) {
+            unit[i] = cpus[i].group < BENCH_MAX_C2C ? cpus[i].group : -1;
+        } else if (cpus[i].rank == 0) {
+            unit[i] = ++n;
+        } else {
+            /* siblings follow their core */
+            for (j = 0; j < i; j++)
+                if (cpus[j].rank == 0 && cpus[j].socket_id == cpus[i].socket_id &&
+                    cpus[j].core_id == cpus[i].core_id) break;
+            unit[i] = (j < i) ? unit[j] : -1;
+        }
+        if (unit[i] < 0) continue;
+        if (by_core && cpus[i].rank == 0) r.c2c_unit_cpu[unit[i]] = cpus[i].id;
+        if (!by_core) r.c2c_unit_cpu[unit[i]] = -1;
+        r.c2c_unit_group[unit[i]] = cpus[i].group;
+        r.c2c_unit_socket[unit[i]] = cpus[i].socket_id;
+    }
+    for (i = 0; i < r.c2c_units; i++)
+        for (j = i; j < r.c2c_units; j++) {
+            for (k = n = 0; k < n_pairs; k++) {
+                gint a = unit[pairs[k].a], b = unit[pairs[k].b];
+                /* by CCX, the diagonal is the same CCX pairs */
+                if (!by_core && pairs[k].kind == BENCH_C2C_SMT) continue;
+                if ((a == i && b == j) || (a == j && b == i)) v[n++] = pairs[k].ns;
+            }
+            r.c2c_latency[i][j] = r.c2c_latency[j][i] = c2c_median(v, n);
+        }
+
+    r.threads_used = 2;
+    snprintf(r.extra, sizeof(r.extra), "%d cpus, %d pairs, %d CCX, %d sockets%s",
+             n_cpus, n_pairs, n_groups, n_sockets,
+             skipped ? ", time limit" : "");
+    if (skipped)
+        DEBUG("core to core: %d pairs skipped after %d s", skipped, C2C_MAX_SECONDS);
+
+    g_free(unit);
+    g_free(v);
+    g_free(pairs);
+    g_free(cpus);
+
+out:
+    r.revision = BENCH_REVISION;
+    bench_results[BENCHMARK_C2C] = r;
+}
@@ -54,6 +54,38 @@ void cachemem_do_benchmark(char *dst, char *src, long sz, double *res){
     //printf("- sec=%2.6f\n",sec);
 }
 
+/* cache levels are the ends of latency plateaus, sizes where latency grows by
+ * less than 30% per doubling. A rise that is not flat for at least two sizes
+ * is the partly cached transition into the next level, or TLB misses, and
+ * does not count. The last plateau is memory. */
+static void cachemem_levels(bench_value *r)
+{
+    int i, start = 0;
+
+    r->cache_levels = 0;
+    for (i = 1; i < r->latency_steps; i++) {
+        if (r->latency[i] <= r->latency[i - 1] * 1.3f)
+            continue;
+        if (i - start >= 2 && r->cache_levels < BENCH_MAX_LEVELS)
+            r->cache_level_kib[r->cache_levels++] = 1 << (i - 1);
+        start = i;
+    }
+}
+
+/* latency ladder: ns per dependent load at each size */
+static void cachemem_latency(char *buf, unsigned long SZ, bench_value *r)
+{
+    gint64 start = bench_time_usec();
+    int i;
+
+    for (i = 0; i < BENCH_MAX_LATENCY && (1024UL << i) <= SZ; i++) {
+        r->latency[i] = bench_chase_ns(bench_chase_chain(buf, 1024L << i));
+        if (bench_time_usec() - start > 5000000) { i++; break; }
+    }
+    r->latency_steps = i;
+    cachemem_levels(r);
+}
+
 static bench_value cacchemem_runtest(unsigned long SZ){
     bench_value ret = EMPTY_BENCH_VALUE;
     char *buf;
@@ -90,9 +122,12 @@ static bench_value cacchemem_runtest(unsigned long SZ){
 	sz<<=1;
     }
 
-    g_free(buf);
-    
     ret.elapsed_time = ((clock()-start)/(double)CLOCKS_PER_SEC);
+
+    //not part of the score, in its own fields
+    cachemem_latency(foo, SZ, &ret);
+    g_free(buf);
+
     cachespeed=(res[8]+res[10]+res[12]+res[14])/4;
     ret.result = (cachespeed+((res[16]+res[18]+res[20]+res[22])/4-cachespeed)/2)*1024;
     if(SZ<128L*1024*1024) {res[26]=res[24];res[25]=res[24];}
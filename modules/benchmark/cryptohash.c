@@ -58,6 +58,7 @@ benchmark_cryptohash(void)
 {
     bench_value r = EMPTY_BENCH_VALUE;
     gchar *test_data = get_test_data(BENCH_DATA_SIZE);
+    gint sha1, sha256, failed;
     if (!test_data) return;
 
     shell_view_set_enabled(FALSE);
@@ -65,9 +66,22 @@ benchmark_cryptohash(void)
 
     gchar *d = md5_digest_str(test_data, BENCH_DATA_SIZE);
     //if (!SEQ(d, BENCH_DATA_MD5))
-    r = benchmark_crunch_for(CRUNCH_TIME, 0, cryptohash_for, test_data);
+    r = benchmark_crunch_for_local(CRUNCH_TIME, 0, cryptohash_for, test_data, BENCH_DATA_SIZE);
     r.revision = BENCH_REVISION;
-    snprintf(r.extra, 255, "r:%d, d:%s", STEPS, d);
+
+    /* SHA-1/SHA-256 code paths, next to the result */
+    shell_status_update("Running CryptoHash code paths...");
+    failed = bench_hash_paths(&r, test_data, BENCH_DATA_SIZE);
+    sha1 = bench_hash_best_path(&r, BENCH_HASH_SHA1);
+    sha256 = bench_hash_best_path(&r, BENCH_HASH_SHA256);
+    snprintf(r.extra, sizeof(r.extra),
+             "r:%d, d:%s, SHA-1 %.0f MB/s %s (scalar %.0f), SHA-256 %.0f MB/s %s (scalar %.0f)%s",
+             STEPS, d,
+             r.hash_mbs[BENCH_HASH_SHA1][sha1], bench_hash_path_name(sha1),
+             r.hash_mbs[BENCH_HASH_SHA1][BENCH_HASH_SCALAR],
+             r.hash_mbs[BENCH_HASH_SHA256][sha256], bench_hash_path_name(sha256),
+             r.hash_mbs[BENCH_HASH_SHA256][BENCH_HASH_SCALAR],
+             failed ? ", wrong digest" : "");
 
     g_free(test_data);
     g_free(d);
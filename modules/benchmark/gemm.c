@@ -0,0 +1,407 @@
+/*
+ *    hardinfo2 - System Information and Benchmark
+ *    Copyright (C) 2026 hardinfo2 project
+ *    License: GPL2+
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License v2.0 or later.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/* Dense matrix multiply, C += A * B, FP64 and FP32.
+ *
+ * The usual blocked layout: a KC deep panel of B and an MC x KC block of A
+ * are packed so the micro-kernel streams both, and the kernel keeps an
+ * MR x NR block of C in vector registers for the whole panel. The kernels
+ * are one body on GCC vector types, built for SSE2, AVX2+FMA, AVX-512F or
+ * NEON; the best the cpu has is used. Each worker owns a slab of C columns
+ * and multiplies it over and over for half a second, single thread on a
+ * 512 matrix, all threads on 1024 (2048 above 16 threads). Samples of C are
+ * checked against a plain dot product. The peak is cores x max frequency x
+ * FLOPs per cycle of the ISA, two FMA pipes assumed where there is FMA. The
+ * result is FP64 GFLOPS on all threads. */
+
+#include <string.h>
+#include <math.h>
+
+#include "hardinfo.h"
+#include "cpu_util.h"
+#include "benchmark.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define GEMM_X86 1
+#endif
+
+/* if anything changes in this block, increment revision */
+#define BENCH_REVISION 1
+#define GEMM_N_SINGLE 512
+#define GEMM_N_ALL 1024
+#define GEMM_N_LARGE 2048
+#define GEMM_KC 256
+#define GEMM_MC 192 /* a multiple of every MR */
+#define GEMM_MAX_MR 12
+#define GEMM_MAX_NR 32
+#define GEMM_USEC 500000
+
+typedef double gemm_v2d __attribute__((vector_size(16)));
+typedef float gemm_v4f __attribute__((vector_size(16)));
+typedef double gemm_v4d __attribute__((vector_size(32)));
+typedef float gemm_v8f __attribute__((vector_size(32)));
+typedef double gemm_v8d __attribute__((vector_size(64)));
+typedef float gemm_v16f __attribute__((vector_size(64)));
+
+typedef void (*gemm_kernel_d)(gsize kc, const double *a, const double *b, double *c, gsize ldc);
+typedef void (*gemm_kernel_f)(gsize kc, const float *a, const float *b, float *c, gsize ldc);
+
+/* C[MR][NV vectors] += packed A (MR per k) x packed B (NV vectors per k) */
+#define GEMM_KERNEL(T, V, MR, NV)                                             \
+    V acc[MR][NV], bv[NV];                                                    \
+    const int vl = sizeof(V) / sizeof(T);                                     \
+    gsize p;                                                                  \
+    int i, j;                                                                 \
+                                                                              \
+    _Pragma("GCC unroll 16")                                                  \
+    for (i = 0; i < MR; i++)                                                  \
+        _Pragma("GCC unroll 4")                                               \
+        for (j = 0; j < NV; j++)                                              \
+            memcpy(&acc[i][j], c + i * ldc + j * vl, sizeof(V));              \
+    for (p = 0; p < kc; p++, a += MR, b += NV * vl) {                         \
+        _Pragma("GCC unroll 4")                                               \
+        for (j = 0; j < NV; j++)                                              \
+            memcpy(&bv[j], b + j * vl, sizeof(V));                            \
+        _Pragma("GCC unroll 16")                                              \
+        for (i = 0; i < MR; i++)                                              \
+            _Pragma("GCC unroll 4")                                           \
+            for (j = 0; j < NV; j++)                                          \
+                acc[i][j] += a[i] * bv[j];                                    \
+    }                                                                         \
+    _Pragma("GCC unroll 16")                                                  \
+    for (i = 0; i < MR; i++)                                                  \
+        _Pragma("GCC unroll 4")                                               \
+        for (j = 0; j < NV; j++)                                              \
+            memcpy(c + i * ldc + j * vl, &acc[i][j], sizeof(V));
+
+/* SSE2 on x86, NEON on arm64, whatever the compiler makes of it elsewhere */
+static void gemm_d_128(gsize kc, const double *a, const double *b, double *c, gsize ldc)
+{
+#ifdef __aarch64__
+    GEMM_KERNEL(double, gemm_v2d, 8, 2)
+#else
+    GEMM_KERNEL(double, gemm_v2d, 4, 2)
+#endif
+}
+
+static void gemm_f_128(gsize kc, const float *a, const float *b, float *c, gsize ldc)
+{
+#ifdef __aarch64__
+    GEMM_KERNEL(float, gemm_v4f, 8, 2)
+#else
+    GEMM_KERNEL(float, gemm_v4f, 4, 2)
+#endif
+}
+
+#ifdef GEMM_X86
+__attribute__((target("avx2,fma")))
+static void gemm_d_avx2(gsize kc, const double *a, const double *b, double *c, gsize ldc)
+{
+    GEMM_KERNEL(double, gemm_v4d, 6, 2)
+}
+
+__attribute__((target("avx2,fma")))
+static void gemm_f_avx2(gsize kc, const float *a, const float *b, float *c, gsize ldc)
+{
+    GEMM_KERNEL(float, gemm_v8f, 6, 2)
+}
+
+__attribute__((target("avx512f")))
+static void gemm_d_avx512(gsize kc, const double *a, const double *b, double *c, gsize ldc)
+{
+    GEMM_KERNEL(double, gemm_v8d, 12, 2)
+}
+
+__attribute__((target("avx512f")))
+static void gemm_f_avx512(gsize kc, const float *a, const float *b, float *c, gsize ldc)
+{
+    GEMM_KERNEL(float, gemm_v16f, 12, 2)
+}
+#endif
+
+/* best first; nr in elements, FP64 FLOPs per cycle per core */
+static const struct {
+    const gchar *name;
+    gint mr, nr_d, nr_f;
+    gint flops_cycle;
+    gemm_kernel_d kd;
+    gemm_kernel_f kf;
+} gemm_paths[] = {
+#ifdef GEMM_X86
+    { "AVX-512", 12, 16, 32, 32, gemm_d_avx512, gemm_f_avx512 },
+    { "AVX2", 6, 8, 16, 16, gemm_d_avx2, gemm_f_avx2 },
+    { "SSE2", 4, 4, 8, 4, gemm_d_128, gemm_f_128 },
+#elif defined(__aarch64__)
+    { "NEON", 8, 4, 8, 8, gemm_d_128, gemm_f_128 },
+#else
+    { "Generic", 4, 4, 8, 2, gemm_d_128, gemm_f_128 },
+#endif
+};
+
+static gint gemm_path(void)
+{
+#ifdef GEMM_X86
+    if (__builtin_cpu_supports("avx512f")) return 0;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return 1;
+    return 2;
+#else
+    return 0;
+#endif
+}
+
+typedef struct {
+    gint path, fp32, threads;
+    gsize n;
+    gpointer a, b, c;
+    gint *reps;         /* per thread */
+    gsize *j0, *j1;     /* column slab per thread */
+} gemm_job;
+
+/* C[:, j0:j1] += A * B[:, j0:j1], row major, edges through a scratch tile */
+#define GEMM_SLAB(T, NR, KERNEL)                                              \
+    const T *A = job->a, *B = job->b;                                         \
+    T *C = job->c, tile[GEMM_MAX_MR * GEMM_MAX_NR];                           \
+    gsize n = job->n, mr = gemm_paths[job->path].mr, nr = NR;                 \
+    gsize pc, kc, ic, mc, ir, jr, p, i, j, rows, cols;                        \
+                                                                              \
+    for (pc = 0; pc < n; pc += kc) {                                          \
+        kc = MIN(GEMM_KC, n - pc);                                            \
+        for (jr = j0; jr < j1; jr += nr)                                      \
+            for (p = 0; p < kc; p++)                                          \
+                for (j = 0; j < nr; j++)                                      \
+                    bpack[(jr - j0) * kc + p * nr + j] =                      \
+                        (jr + j < j1) ? B[(pc + p) * n + jr + j] : 0;         \
+        for (ic = 0; ic < n; ic += mc) {                                      \
+            mc = MIN(GEMM_MC, n - ic);                                        \
+            for (ir = 0; ir < mc; ir += mr)                                   \
+                for (p = 0; p < kc; p++)                                      \
+                    for (i = 0; i < mr; i++)                                  \
+                        apack[ir * kc + p * mr + i] =                         \
+                            (ir + i < mc) ? A[(ic + ir + i) * n + pc + p] : 0; \
+            for (jr = j0; jr < j1; jr += nr) {                                \
+                for (ir = 0; ir < mc; ir += mr) {                             \
+                    T *c = C + (ic + ir) * n + jr;                            \
+                    rows = MIN(mr, mc - ir);                                  \
+                    cols = MIN(nr, j1 - jr);                                  \
+                    if (rows == mr && cols == nr) {                           \
+                        KERNEL(kc, apack + ir * kc, bpack + (jr - j0) * kc, c, n); \
+                        continue;                                             \
+                    }                                                         \
+                    memset(tile, 0, sizeof(tile));                            \
+                    for (i = 0; i < rows; i++)                                \
+                        memcpy(tile + i * nr, c + i * n, cols * sizeof(T));   \
+                    KERNEL(kc, apack + ir * kc, bpack + (jr - j0) * kc, tile, nr); \
+                    for (i = 0; i < rows; i++)                                \
+                        memcpy(c + i * n, tile + i * nr, cols * sizeof(T));   \
+                }                                                             \
+            }                                                                 \
+        }                                                                     \
+    }
+
+static void gemm_slab_d(const gemm_job *job, gsize j0, gsize j1, double *apack, double *bpack)
+{
+    GEMM_SLAB(double, gemm_paths[job->path].nr_d, gemm_paths[job->path].kd)
+}
+
+static void gemm_slab_f(const gemm_job *job, gsize j0, gsize j1, float *apack, float *bpack)
+{
+    GEMM_SLAB(float, gemm_paths[job->path].nr_f, gemm_paths[job->path].kf)
+}
+
+static gpointer gemm_thread(unsigned int start, unsigned int end, void *data, gint thread_number)
+{
+    gemm_job *job = (gemm_job *)data;
+    gsize j0 = job->j0[thread_number], j1 = job->j1[thread_number];
+    gsize size = job->fp32 ? sizeof(float) : sizeof(double);
+    gsize nr = job->fp32 ? gemm_paths[job->path].nr_f : gemm_paths[job->path].nr_d;
+    gpointer apack, bpack;
+    double *gflops;
+    gint64 t0, usec;
+    gint reps = 0;
+
+    if (j0 >= j1)
+        return NULL;
+    apack = g_malloc(GEMM_MC * GEMM_KC * size);
+    bpack = g_malloc((j1 - j0 + nr) * GEMM_KC * size);
+
+    t0 = bench_time_usec();
+    do {
+        if (job->fp32)
+            gemm_slab_f(job, j0, j1, apack, bpack);
+        else
+            gemm_slab_d(job, j0, j1, apack, bpack);
+        reps++;
+        usec = bench_time_usec() - t0;
+    } while (usec < GEMM_USEC);
+
+    job->reps[thread_number] = reps;
+    gflops = g_new(double, 1);
+    *gflops = 2.0 * job->n * job->n * (j1 - j0) * reps / usec / 1000.0;
+    g_free(apack);
+    g_free(bpack);
+    return gflops;
+}
+
+/* a few entries of every slab against reps x the dot product */
+static gboolean gemm_check(const gemm_job *job)
+{
+    gsize n = job->n, i, j, k;
+    gint t, s;
+
+    for (t = 0; t < job->threads; t++) {
+        if (job->j0[t] >= job->j1[t]) continue;
+        for (s = 0; s < 4; s++) {
+            double dot = 0, sum_abs = 0, c, x;
+            i = (s * 7919 + t * 131) % n;
+            j = job->j0[t] + (s * 104729) % (job->j1[t] - job->j0[t]);
+            for (k = 0; k < n; k++) {
+                x = job->fp32 ? (double)((float *)job->a)[i * n + k] * ((float *)job->b)[k * n + j]
+                              : ((double *)job->a)[i * n + k] * ((double *)job->b)[k * n + j];
+                dot += x;
+                sum_abs += fabs(x);
+            }
+            c = job->fp32 ? ((float *)job->c)[i * n + j] : ((double *)job->c)[i * n + j];
+            if (fabs(c - dot * job->reps[t]) > (job->fp32 ? 1e-4 : 1e-10) * sum_abs * job->reps[t])
+                return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/* GFLOPS of one run, -1 if out of memory or wrong */
+static double gemm_run(gint path, gint fp32, gint threads, gsize n)
+{
+    gemm_job job = { .path = path, .fp32 = fp32, .threads = threads, .n = n };
+    gsize size = fp32 ? sizeof(float) : sizeof(double), i;
+    gsize nr = fp32 ? gemm_paths[path].nr_f : gemm_paths[path].nr_d;
+    gsize units = (n + nr - 1) / nr;
+    bench_value v;
+    gint t;
+
+    job.a = g_try_malloc(n * n * size);
+    job.b = g_try_malloc(n * n * size);
+    job.c = g_try_malloc0(n * n * size);
+    if (!job.a || !job.b || !job.c) {
+        v.result = -1;
+        goto out;
+    }
+    for (i = 0; i < n * n; i++) {
+        double x = (double)((i * 7919) % 1000) / 500.0 - 1.0;
+        double y = (double)((i * 104729 + 17) % 1000) / 500.0 - 1.0;
+        if (fp32) {
+            ((float *)job.a)[i] = x;
+            ((float *)job.b)[i] = y;
+        } else {
+            ((double *)job.a)[i] = x;
+            ((double *)job.b)[i] = y;
+        }
+    }
+
+    job.reps = g_new0(gint, threads);
+    job.j0 = g_new0(gsize, threads);
+    job.j1 = g_new0(gsize, threads);
+    for (t = 0; t < threads; t++) {
+        job.j0[t] = MIN(n, units * t / threads * nr);
+        job.j1[t] = MIN(n, units * (t + 1) / threads * nr);
+    }
+
+    v = benchmark_parallel(threads, gemm_thread, &job);
+    if (!gemm_check(&job))
+        v.result = -1;
+
+out:
+    g_free(job.a);
+    g_free(job.b);
+    g_free(job.c);
+    g_free(job.reps);
+    g_free(job.j0);
+    g_free(job.j1);
+    return v.result;
+}
+
+/* max of cpu0 from cpufreq, else what /proc/cpuinfo says, 0 if neither */
+static double gemm_mhz(void)
+{
+    cpufreq_data *cpufd = cpufreq_new(0);
+    gchar *cpuinfo = NULL, *p;
+    double mhz = cpufd->cpukhz_max / 1000.0;
+
+    cpufreq_free(cpufd);
+    if (mhz <= 0 && g_file_get_contents("/proc/cpuinfo", &cpuinfo, NULL, NULL)) {
+        if ((p = strstr(cpuinfo, "cpu MHz")) && (p = strchr(p, ':')))
+            mhz = g_ascii_strtod(p + 1, NULL);
+        g_free(cpuinfo);
+    }
+    return mhz;
+}
+
+void benchmark_gemm(void)
+{
+    bench_value r = EMPTY_BENCH_VALUE;
+    int cpu_cores, cpu_threads, prec, all;
+    gint path = gemm_path();
+    double mhz;
+    GTimer *timer;
+
+    shell_view_set_enabled(FALSE);
+    shell_status_update("Running GEMM benchmark...");
+
+    bench_workers_cores_threads(&cpu_cores, &cpu_threads);
+    cpu_threads = MAX(cpu_threads, 1);
+    cpu_cores = MAX(cpu_cores, 1);
+    mhz = gemm_mhz();
+
+    timer = g_timer_new();
+    for (prec = 0; prec < BENCH_GEMM_PRECISIONS; prec++) {
+        for (all = 0; all < 2; all++) {
+            r.gemm_gflops[prec][all] =
+                gemm_run(path, prec == BENCH_GEMM_FP32, all ? cpu_threads : 1,
+                         !all ? GEMM_N_SINGLE : cpu_threads > 16 ? GEMM_N_LARGE : GEMM_N_ALL);
+            r.gemm_peak[prec][all] = mhz <= 0 ? -1 :
+                (all ? cpu_cores : 1) * mhz / 1000.0 * gemm_paths[path].flops_cycle *
+                (prec == BENCH_GEMM_FP32 ? 2 : 1);
+        }
+    }
+    r.elapsed_time = g_timer_elapsed(timer, NULL);
+    g_timer_destroy(timer);
+    r.gemm = 1;
+
+    r.result = r.gemm_gflops[BENCH_GEMM_FP64][1];
+    r.threads_used = cpu_threads;
+    if (r.gemm_gflops[0][0] < 0 || r.gemm_gflops[0][1] < 0 ||
+        r.gemm_gflops[1][0] < 0 || r.gemm_gflops[1][1] < 0) {
+        r.result = -1;
+        snprintf(r.extra, sizeof(r.extra), "%s, verification failed", gemm_paths[path].name);
+    } else {
+        snprintf(r.extra, sizeof(r.extra),
+                 "FP64 %.1f/%.1f FP32 %.1f/%.1f GFLOPS at 1/%d threads, %s, ",
+                 r.gemm_gflops[0][0], r.gemm_gflops[0][1], r.gemm_gflops[1][0],
+                 r.gemm_gflops[1][1], cpu_threads, gemm_paths[path].name);
+        if (r.gemm_peak[BENCH_GEMM_FP64][1] > 0)
+            snprintf(r.extra + strlen(r.extra), sizeof(r.extra) - strlen(r.extra),
+                     "%.0f%% of %.0f GFLOPS peak at %.0f MHz",
+                     100 * r.gemm_gflops[BENCH_GEMM_FP64][1] / r.gemm_peak[BENCH_GEMM_FP64][1],
+                     r.gemm_peak[BENCH_GEMM_FP64][1], mhz);
+        else
+            snprintf(r.extra + strlen(r.extra), sizeof(r.extra) - strlen(r.extra),
+                     "peak unknown");
+    }
+
+    r.revision = BENCH_REVISION;
+    bench_results[BENCHMARK_GEMM] = r;
+}
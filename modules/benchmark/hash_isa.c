@@ -0,0 +1,515 @@
+/*
+ *    hardinfo2 - System Information and Benchmark
+ *    Copyright (C) 2026 hardinfo2 project
+ *    License: GPL2+
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License v2.0 or later.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/* SHA-1 and SHA-256 code paths for CryptoHash, picked at run time.
+ *
+ * Scalar is portable C. The multi-buffer paths hash 4, 8 or 16 messages at
+ * once, one per vector lane; they are the scalar rounds on GCC vector types,
+ * built for SSE2/NEON, AVX2 and AVX-512F. SHA-NI and the ARMv8 SHA
+ * instructions hash one message. Every path the cpu has must give the scalar
+ * digest of the test data, then runs on all threads for a quarter second.
+ * Lanes hash the same 64 KiB, so all paths read from cache. MB/s is of
+ * message bytes, all lanes counted. */
+
+#include <string.h>
+
+#include "hardinfo.h"
+#include "benchmark.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define HASH_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+#if defined(__aarch64__)
+#define HASH_ARM 1
+#include <sys/auxv.h>
+#include <arm_neon.h>
+#ifndef HWCAP_SHA1
+#define HWCAP_SHA1 (1 << 5)
+#endif
+#ifndef HWCAP_SHA2
+#define HWCAP_SHA2 (1 << 6)
+#endif
+#endif
+
+#define HASH_USEC 250000
+#define HASH_MAX_LANES 16
+
+typedef void (*hash_fn)(guint32 (*state)[8], const guchar **data, gsize blocks);
+typedef guint32 hash_v4 __attribute__((vector_size(16)));
+typedef guint32 hash_v8 __attribute__((vector_size(32)));
+typedef guint32 hash_v16 __attribute__((vector_size(64)));
+
+static const guint32 sha1_init[5] = {
+    0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0 };
+
+static const guint32 sha256_init[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+
+static const guint32 sha256_k[64] __attribute__((aligned(16))) = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2 };
+
+static const gchar *hash_path_names[BENCH_HASH_PATHS] = {
+    [BENCH_HASH_SCALAR] = "Scalar",
+    [BENCH_HASH_MB4] = "SIMD x4",
+    [BENCH_HASH_AVX2] = "AVX2 x8",
+    [BENCH_HASH_AVX512] = "AVX-512 x16",
+    [BENCH_HASH_SHA_NI] = "SHA-NI",
+    [BENCH_HASH_ARMV8] = "ARMv8 SHA",
+};
+
+static inline guint32 hash_be32(const guchar *p)
+{
+    guint32 v;
+    memcpy(&v, p, sizeof(v));
+    return GUINT32_FROM_BE(v);
+}
+
+/* both for guint32 and the vector types */
+#define ROL(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+#define ROR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+/* SHA-1 rounds on LANES messages, V holds word i of every lane */
+#define SHA1_BODY(V, LANES)                                                   \
+    V s[5], w[16], a, b, c, d, e, t;                                          \
+    guint32 lane[LANES];                                                      \
+    gsize blk;                                                                \
+    int i, l;                                                                 \
+                                                                              \
+    for (i = 0; i < 5; i++) {                                                 \
+        for (l = 0; l < LANES; l++) lane[l] = state[l][i];                    \
+        memcpy(&s[i], lane, sizeof(V));                                       \
+    }                                                                         \
+    for (blk = 0; blk < blocks; blk++) {                                      \
+        a = s[0]; b = s[1]; c = s[2]; d = s[3]; e = s[4];                     \
+        for (i = 0; i < 80; i++) {                                            \
+            if (i < 16) {                                                     \
+                for (l = 0; l < LANES; l++)                                   \
+                    lane[l] = hash_be32(data[l] + 64 * blk + 4 * i);          \
+                memcpy(&w[i], lane, sizeof(V));                               \
+            } else {                                                          \
+                t = w[(i + 13) & 15] ^ w[(i + 8) & 15] ^ w[(i + 2) & 15] ^ w[i & 15]; \
+                w[i & 15] = ROL(t, 1);                                        \
+            }                                                                 \
+            if (i < 20) t = ((b & (c ^ d)) ^ d) + 0x5a827999;                 \
+            else if (i < 40) t = (b ^ c ^ d) + 0x6ed9eba1;                    \
+            else if (i < 60) t = ((b & c) | (d & (b | c))) + 0x8f1bbcdc;      \
+            else t = (b ^ c ^ d) + 0xca62c1d6;                                \
+            t += ROL(a, 5) + e + w[i & 15];                                   \
+            e = d; d = c; c = ROL(b, 30); b = a; a = t;                       \
+        }                                                                     \
+        s[0] += a; s[1] += b; s[2] += c; s[3] += d; s[4] += e;                \
+    }                                                                         \
+    for (i = 0; i < 5; i++) {                                                 \
+        memcpy(lane, &s[i], sizeof(V));                                       \
+        for (l = 0; l < LANES; l++) state[l][i] = lane[l];                    \
+    }
+
+/* SHA-256 rounds on LANES messages */
+#define SHA256_BODY(V, LANES)                                                 \
+    V s[8], w[16], a, b, c, d, e, f, g, h, t1, t2;                            \
+    guint32 lane[LANES];                                                      \
+    gsize blk;                                                                \
+    int i, l;                                                                 \
+                                                                              \
+    for (i = 0; i < 8; i++) {                                                 \
+        for (l = 0; l < LANES; l++) lane[l] = state[l][i];                    \
+        memcpy(&s[i], lane, sizeof(V));                                       \
+    }                                                                         \
+    for (blk = 0; blk < blocks; blk++) {                                      \
+        a = s[0]; b = s[1]; c = s[2]; d = s[3];                               \
+        e = s[4]; f = s[5]; g = s[6]; h = s[7];                               \
+        for (i = 0; i < 64; i++) {                                            \
+            if (i < 16) {                                                     \
+                for (l = 0; l < LANES; l++)                                   \
+                    lane[l] = hash_be32(data[l] + 64 * blk + 4 * i);          \
+                memcpy(&w[i], lane, sizeof(V));                               \
+            } else {                                                          \
+                t1 = w[(i + 14) & 15];                                        \
+                t2 = w[(i + 1) & 15];                                         \
+                w[i & 15] += (ROR(t1, 17) ^ ROR(t1, 19) ^ (t1 >> 10)) +       \
+                             w[(i + 9) & 15] +                                \
+                             (ROR(t2, 7) ^ ROR(t2, 18) ^ (t2 >> 3));          \
+            }                                                                 \
+            t1 = h + (ROR(e, 6) ^ ROR(e, 11) ^ ROR(e, 25)) +                  \
+                 ((e & f) ^ (~e & g)) + sha256_k[i] + w[i & 15];              \
+            t2 = (ROR(a, 2) ^ ROR(a, 13) ^ ROR(a, 22)) +                      \
+                 ((a & b) ^ (a & c) ^ (b & c));                               \
+            h = g; g = f; f = e; e = d + t1;                                  \
+            d = c; c = b; b = a; a = t1 + t2;                                 \
+        }                                                                     \
+        s[0] += a; s[1] += b; s[2] += c; s[3] += d;                           \
+        s[4] += e; s[5] += f; s[6] += g; s[7] += h;                           \
+    }                                                                         \
+    for (i = 0; i < 8; i++) {                                                 \
+        memcpy(lane, &s[i], sizeof(V));                                       \
+        for (l = 0; l < LANES; l++) state[l][i] = lane[l];                    \
+    }
+
+static void sha1_scalar(guint32 (*state)[8], const guchar **data, gsize blocks)
+{
+    SHA1_BODY(guint32, 1)
+}
+
+static void sha256_scalar(guint32 (*state)[8], const guchar **data, gsize blocks)
+{
+    SHA256_BODY(guint32, 1)
+}
+
+static void sha1_mb4(guint32 (*state)[8], const guchar **data, gsize blocks)
+{
+    SHA1_BODY(hash_v4, 4)
+}
+
+static void sha256_mb4(guint32 (*state)[8], const guchar **data, gsize blocks)
+{
+    SHA256_BODY(hash_v4, 4)
+}
+
+#ifdef HASH_X86
+__attribute__((target("avx2")))
+static void sha1_avx2(guint32 (*state)[8], const guchar **data, gsize blocks)
+{
+    SHA1_BODY(hash_v8, 8)
+}
+
+__attribute__((target("avx2")))
+static void sha256_avx2(guint32 (*state)[8], const guchar **data, gsize blocks)
+{
+    SHA256_BODY(hash_v8, 8)
+}
+
+__attribute__((target("avx512f")))
+static void sha1_avx512(guint32 (*state)[8], const guchar **data, gsize blocks)
+{
+    SHA1_BODY(hash_v16, 16)
+}
+
+__attribute__((target("avx512f")))
+static void sha256_avx512(guint32 (*state)[8], const guchar **data, gsize blocks)
+{
+    SHA256_BODY(hash_v16, 16)
+}
+
+/* four rounds per sha1rnds4, the function is an immediate */
+__attribute__((target("sha,sse4.1")))
+static void sha1_shani(guint32 (*state)[8], const guchar **data, gsize blocks)
+{
+    const __m128i mask = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+    const guchar *p = data[0];
+    __m128i abcd, abcd_save, e0, e0_save, e, prev, msg[4];
+    int i;
+
+    abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)state[0]), 0x1b);
+    e0 = _mm_set_epi32(state[0][4], 0, 0, 0);
+
+    for (; blocks; blocks--, p += 64) {
+        abcd_save = abcd;
+        e0_save = e0;
+        for (i = 0; i < 4; i++)
+            msg[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(p + 16 * i)), mask);
+
+        prev = abcd;
+        for (i = 0; i < 20; i++) {
+            e = i ? _mm_sha1nexte_epu32(prev, msg[i & 3]) : _mm_add_epi32(e0, msg[0]);
+            prev = abcd;
+            switch (i / 5) {
+            case 0: abcd = _mm_sha1rnds4_epu32(abcd, e, 0); break;
+            case 1: abcd = _mm_sha1rnds4_epu32(abcd, e, 1); break;
+            case 2: abcd = _mm_sha1rnds4_epu32(abcd, e, 2); break;
+            default: abcd = _mm_sha1rnds4_epu32(abcd, e, 3); break;
+            }
+            if (i < 16)
+                msg[i & 3] = _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(msg[i & 3], msg[(i + 1) & 3]),
+                                                              msg[(i + 2) & 3]), msg[(i + 3) & 3]);
+        }
+        e0 = _mm_sha1nexte_epu32(prev, e0_save);
+        abcd = _mm_add_epi32(abcd, abcd_save);
+    }
+
+    _mm_storeu_si128((__m128i *)state[0], _mm_shuffle_epi32(abcd, 0x1b));
+    state[0][4] = _mm_extract_epi32(e0, 3);
+}
+
+/* state kept as ABEF/CDGH, two rounds per sha256rnds2 */
+__attribute__((target("sha,sse4.1")))
+static void sha256_shani(guint32 (*state)[8], const guchar **data, gsize blocks)
+{
+    const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    const guchar *p = data[0];
+    __m128i s0, s1, t, abef_save, cdgh_save, msg[4];
+    int i;
+
+    t = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[0][0]), 0xb1);
+    s1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[0][4]), 0x1b);
+    s0 = _mm_alignr_epi8(t, s1, 8);
+    s1 = _mm_blend_epi16(s1, t, 0xf0);
+
+    for (; blocks; blocks--, p += 64) {
+        abef_save = s0;
+        cdgh_save = s1;
+        for (i = 0; i < 4; i++)
+            msg[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(p + 16 * i)), mask);
+
+        for (i = 0; i < 16; i++) {
+            t = _mm_add_epi32(msg[i & 3], _mm_load_si128((const __m128i *)&sha256_k[4 * i]));
+            s1 = _mm_sha256rnds2_epu32(s1, s0, t);
+            s0 = _mm_sha256rnds2_epu32(s0, s1, _mm_shuffle_epi32(t, 0x0e));
+            if (i < 12)
+                msg[i & 3] = _mm_sha256msg2_epu32(
+                    _mm_add_epi32(_mm_sha256msg1_epu32(msg[i & 3], msg[(i + 1) & 3]),
+                                  _mm_alignr_epi8(msg[(i + 3) & 3], msg[(i + 2) & 3], 4)),
+                    msg[(i + 3) & 3]);
+        }
+        s0 = _mm_add_epi32(s0, abef_save);
+        s1 = _mm_add_epi32(s1, cdgh_save);
+    }
+
+    t = _mm_shuffle_epi32(s0, 0x1b);
+    s1 = _mm_shuffle_epi32(s1, 0xb1);
+    _mm_storeu_si128((__m128i *)&state[0][0], _mm_blend_epi16(t, s1, 0xf0));
+    _mm_storeu_si128((__m128i *)&state[0][4], _mm_alignr_epi8(s1, t, 8));
+}
+#endif
+
+#ifdef HASH_ARM
+__attribute__((target("+crypto")))
+static void sha1_armv8(guint32 (*state)[8], const guchar **data, gsize blocks)
+{
+    const guchar *p = data[0];
+    uint32x4_t abcd, abcd_save, t, msg[4];
+    guint32 e0, e0_save, e1;
+    int i;
+
+    abcd = vld1q_u32(state[0]);
+    e0 = state[0][4];
+
+    for (; blocks; blocks--, p += 64) {
+        abcd_save = abcd;
+        e0_save = e0;
+        for (i = 0; i < 4; i++)
+            msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(p + 16 * i)));
+
+        for (i = 0; i < 20; i++) {
+            t = vaddq_u32(msg[i & 3], vdupq_n_u32(i < 5 ? 0x5a827999 : i < 10 ? 0x6ed9eba1 :
+                                                  i < 15 ? 0x8f1bbcdc : 0xca62c1d6));
+            e1 = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+            if (i < 5) abcd = vsha1cq_u32(abcd, e0, t);
+            else if (i < 10 || i >= 15) abcd = vsha1pq_u32(abcd, e0, t);
+            else abcd = vsha1mq_u32(abcd, e0, t);
+            e0 = e1;
+            if (i < 16)
+                msg[i & 3] = vsha1su1q_u32(vsha1su0q_u32(msg[i & 3], msg[(i + 1) & 3], msg[(i + 2) & 3]),
+                                           msg[(i + 3) & 3]);
+        }
+        abcd = vaddq_u32(abcd, abcd_save);
+        e0 += e0_save;
+    }
+
+    vst1q_u32(state[0], abcd);
+    state[0][4] = e0;
+}
+
+__attribute__((target("+crypto")))
+static void sha256_armv8(guint32 (*state)[8], const guchar **data, gsize blocks)
+{
+    const guchar *p = data[0];
+    uint32x4_t s0, s1, s0_save, s1_save, t, t2, msg[4];
+    int i;
+
+    s0 = vld1q_u32(&state[0][0]);
+    s1 = vld1q_u32(&state[0][4]);
+
+    for (; blocks; blocks--, p += 64) {
+        s0_save = s0;
+        s1_save = s1;
+        for (i = 0; i < 4; i++)
+            msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(p + 16 * i)));
+
+        for (i = 0; i < 16; i++) {
+            t = vaddq_u32(msg[i & 3], vld1q_u32(&sha256_k[4 * i]));
+            if (i < 12)
+                msg[i & 3] = vsha256su1q_u32(vsha256su0q_u32(msg[i & 3], msg[(i + 1) & 3]),
+                                             msg[(i + 2) & 3], msg[(i + 3) & 3]);
+            t2 = s0;
+            s0 = vsha256hq_u32(s0, s1, t);
+            s1 = vsha256h2q_u32(s1, t2, t);
+        }
+        s0 = vaddq_u32(s0, s0_save);
+        s1 = vaddq_u32(s1, s1_save);
+    }
+
+    vst1q_u32(&state[0][0], s0);
+    vst1q_u32(&state[0][4], s1);
+}
+#endif
+
+static const struct {
+    gint lanes;
+    hash_fn fn[BENCH_HASHES];
+} hash_paths[BENCH_HASH_PATHS] = {
+    [BENCH_HASH_SCALAR] = { 1, { sha1_scalar, sha256_scalar } },
+    [BENCH_HASH_MB4] = { 4, { sha1_mb4, sha256_mb4 } },
+#ifdef HASH_X86
+    [BENCH_HASH_AVX2] = { 8, { sha1_avx2, sha256_avx2 } },
+    [BENCH_HASH_AVX512] = { 16, { sha1_avx512, sha256_avx512 } },
+    [BENCH_HASH_SHA_NI] = { 1, { sha1_shani, sha256_shani } },
+#endif
+#ifdef HASH_ARM
+    [BENCH_HASH_ARMV8] = { 1, { sha1_armv8, sha256_armv8 } },
+#endif
+};
+
+static gboolean hash_path_supported(gint path)
+{
+#ifdef HASH_X86
+    unsigned int a, b, c, d;
+#endif
+
+    if (!hash_paths[path].fn[0])
+        return FALSE;
+    switch (path) {
+#ifdef HASH_X86
+    case BENCH_HASH_AVX2:
+        return __builtin_cpu_supports("avx2");
+    case BENCH_HASH_AVX512:
+        return __builtin_cpu_supports("avx512f");
+    case BENCH_HASH_SHA_NI:
+        return __get_cpuid_count(7, 0, &a, &b, &c, &d) && (b & (1 << 29)) &&
+               __builtin_cpu_supports("sse4.1");
+#endif
+#ifdef HASH_ARM
+    case BENCH_HASH_ARMV8:
+        return (getauxval(AT_HWCAP) & (HWCAP_SHA1 | HWCAP_SHA2)) == (HWCAP_SHA1 | HWCAP_SHA2);
+#endif
+    default:
+        return TRUE;
+    }
+}
+
+/* digest of every lane, size a multiple of 64 */
+static void hash_digest(gint path, gint hash, const guchar *msg, gsize size,
+                        guint32 (*state)[8])
+{
+    const guchar *lanes[HASH_MAX_LANES];
+    guchar pad[64] = { 0x80 };
+    guint64 bits = (guint64)size * 8;
+    int l, i;
+
+    for (l = 0; l < hash_paths[path].lanes; l++) {
+        memcpy(state[l], hash == BENCH_HASH_SHA1 ? sha1_init : sha256_init,
+               hash == BENCH_HASH_SHA1 ? sizeof(sha1_init) : sizeof(sha256_init));
+        lanes[l] = msg;
+    }
+    hash_paths[path].fn[hash](state, lanes, size / 64);
+
+    for (i = 0; i < 8; i++)
+        pad[63 - i] = (guchar)(bits >> (8 * i));
+    for (l = 0; l < hash_paths[path].lanes; l++)
+        lanes[l] = pad;
+    hash_paths[path].fn[hash](state, lanes, 1);
+}
+
+typedef struct {
+    hash_fn fn;
+    gint lanes;
+    const guchar *data;
+    gsize size;
+} hash_job;
+
+static gpointer hash_thread(unsigned int start, unsigned int end, void *data, gint thread_number)
+{
+    hash_job *job = (hash_job *)data;
+    guint32 state[HASH_MAX_LANES][8] = { { 0 } };
+    const guchar *lanes[HASH_MAX_LANES];
+    double *mbs = g_new(double, 1);
+    gint64 t0 = bench_time_usec(), usec;
+    guint64 bytes = 0;
+    int l;
+
+    for (l = 0; l < job->lanes; l++)
+        lanes[l] = job->data;
+    do {
+        job->fn(state, lanes, job->size / 64);
+        bytes += job->size * job->lanes;
+        usec = bench_time_usec() - t0;
+    } while (usec < HASH_USEC);
+
+    *mbs = (double)bytes / usec;
+    return mbs;
+}
+
+const gchar *bench_hash_path_name(gint path)
+{
+    return (path >= 0 && path < BENCH_HASH_PATHS) ? hash_path_names[path] : "";
+}
+
+gint bench_hash_best_path(const bench_value *r, gint hash)
+{
+    gint path, best = BENCH_HASH_SCALAR;
+
+    for (path = 0; path < r->hash_paths; path++)
+        if (r->hash_mbs[hash][path] > r->hash_mbs[hash][best])
+            best = path;
+    return best;
+}
+
+/* MB/s on all threads for every code path the cpu has, -1 for the rest;
+ * the number of paths that failed to give the scalar digest */
+gint bench_hash_paths(bench_value *r, const gchar *data, gsize size)
+{
+    guint32 expect[HASH_MAX_LANES][8], got[HASH_MAX_LANES][8];
+    int cpu_cores, cpu_threads, path, hash, l, failed = 0;
+    hash_job job = { .data = (const guchar *)data, .size = size & ~(gsize)63 };
+    bench_value v;
+
+    bench_workers_cores_threads(&cpu_cores, &cpu_threads);
+    r->hash_paths = BENCH_HASH_PATHS;
+    for (hash = 0; hash < BENCH_HASHES; hash++) {
+        hash_digest(BENCH_HASH_SCALAR, hash, job.data, job.size, expect);
+        for (path = 0; path < BENCH_HASH_PATHS; path++) {
+            r->hash_mbs[hash][path] = -1;
+            if (!hash_path_supported(path))
+                continue;
+
+            hash_digest(path, hash, job.data, job.size, got);
+            for (l = 0; l < hash_paths[path].lanes; l++)
+                if (memcmp(got[l], expect[0], hash == BENCH_HASH_SHA1 ? 20 : 32))
+                    break;
+            if (l < hash_paths[path].lanes) {
+                failed++;
+                continue;
+            }
+
+            job.fn = hash_paths[path].fn[hash];
+            job.lanes = hash_paths[path].lanes;
+            v = benchmark_parallel(MAX(cpu_threads, 1), hash_thread, &job);
+            r->hash_mbs[hash][path] = v.result;
+        }
+    }
+    return failed;
+}
@@ -0,0 +1,500 @@
+/*
+ *    hardinfo2 - System Information and Benchmark
+ *    Copyright (C) 2026 hardinfo2 project
+ *    License: GPL2+
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License v2.0 or later.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/* Internal network speed, in process.
+ *
+ * Connected socket pairs are made up front: TCP and UDP on 127.0.0.1 and
+ * AF_UNIX stream sockets. Workers run in pairs, the even one sends 128 KiB
+ * blocks (8 KiB datagrams for UDP) for a second, the odd one receives until
+ * end of stream. Throughput is the bytes received by all streams over the
+ * time from the first send to the last receive. With --bench-zerocopy TCP is
+ * also sent with MSG_ZEROCOPY, sendfile() from a file in the page cache and
+ * vmsplice()/splice() through a pipe. Round trips are 64 byte ping-pong,
+ * every message timed for the percentiles. Result is one TCP stream in
+ * Gbit/s, the same as the iperf3 run this replaces. */
+
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/sendfile.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <linux/errqueue.h>
+
+#include "hardinfo.h"
+#include "benchmark.h"
+
+/* if anything changes in this block, increment revision */
+#define BENCH_REVISION 1
+#define NET_BLOCK (128 * 1024)
+#define NET_UDP_BLOCK 8192
+#define NET_MSG 64
+#define NET_FILE (4 * 1024 * 1024)
+#define NET_PIPE (64 * 1024)
+#define NET_MAX_STREAMS 8
+#define NET_STREAM_NSEC 1000000000L
+#define NET_RTT_NSEC 300000000L
+#define NET_RTT_WARMUP 100
+#define NET_TIMEOUT_USEC 5000000
+#define NET_UDP_TIMEOUT_USEC 200000
+
+#if defined(MSG_ZEROCOPY) && defined(SO_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+#define NET_ZEROCOPY 1
+#endif
+
+enum { NET_SEND_COPY, NET_SEND_ZEROCOPY, NET_SEND_SENDFILE, NET_SEND_SPLICE };
+
+static const struct {
+    int domain, type;
+    gboolean streams;
+    int send;
+} net_tests[BENCH_NET_TESTS] = {
+    [BENCH_NET_TCP] = { AF_INET, SOCK_STREAM, FALSE, NET_SEND_COPY },
+    [BENCH_NET_TCP_STREAMS] = { AF_INET, SOCK_STREAM, TRUE, NET_SEND_COPY },
+    [BENCH_NET_UDP_STREAMS] = { AF_INET, SOCK_DGRAM, TRUE, NET_SEND_COPY },
+    [BENCH_NET_UNIX_STREAMS] = { AF_UNIX, SOCK_STREAM, TRUE, NET_SEND_COPY },
+    [BENCH_NET_TCP_ZEROCOPY] = { AF_INET, SOCK_STREAM, TRUE, NET_SEND_ZEROCOPY },
+    [BENCH_NET_TCP_SENDFILE] = { AF_INET, SOCK_STREAM, TRUE, NET_SEND_SENDFILE },
+    [BENCH_NET_TCP_SPLICE] = { AF_INET, SOCK_STREAM, TRUE, NET_SEND_SPLICE },
+};
+
+static const struct {
+    int domain, type;
+} net_rtts[BENCH_NET_RTTS] = {
+    [BENCH_NET_RTT_TCP] = { AF_INET, SOCK_STREAM },
+    [BENCH_NET_RTT_UDP] = { AF_INET, SOCK_DGRAM },
+    [BENCH_NET_RTT_UNIX] = { AF_UNIX, SOCK_STREAM },
+};
+
+typedef struct {
+    gint type, send, streams;
+    int fd[NET_MAX_STREAMS][2]; /* sender, receiver */
+    int file;                   /* sendfile() source */
+    gint64 start[NET_MAX_STREAMS], end[NET_MAX_STREAMS];
+    guint64 sent[NET_MAX_STREAMS], received[NET_MAX_STREAMS];
+    gint errors, copied;
+    GArray *rtt; /* float usec */
+} net_data;
+
+static void net_timeout(int fd, int opt, glong usec)
+{
+    struct timeval tv = { usec / 1000000, usec % 1000000 };
+    setsockopt(fd, SOL_SOCKET, opt, &tv, sizeof(tv));
+}
+
+/* fd[0] and fd[1] connected to each other */
+static gboolean net_pair(int domain, int type, int fd[2])
+{
+    struct sockaddr_in a = { 0 }, b = { 0 };
+    socklen_t len = sizeof(a);
+    int one = 1, l;
+
+    fd[0] = fd[1] = -1;
+    if (domain == AF_UNIX)
+        return socketpair(AF_UNIX, type | SOCK_CLOEXEC, 0, fd) == 0;
+
+    a.sin_family = AF_INET;
+    a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (type == SOCK_DGRAM) {
+        b = a;
+        fd[0] = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        fd[1] = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (fd[0] < 0 || fd[1] < 0 ||
+            bind(fd[0], (struct sockaddr *)&a, sizeof(a)) ||
+            bind(fd[1], (struct sockaddr *)&b, sizeof(b)) ||
+            getsockname(fd[0], (struct sockaddr *)&a, &len) ||
+            getsockname(fd[1], (struct sockaddr *)&b, &len) ||
+            connect(fd[0], (struct sockaddr *)&b, sizeof(b)) ||
+            connect(fd[1], (struct sockaddr *)&a, sizeof(a)))
+            goto fail;
+        return TRUE;
+    }
+
+    l = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (l < 0) return FALSE;
+    if (bind(l, (struct sockaddr *)&a, sizeof(a)) || listen(l, 1) ||
+        getsockname(l, (struct sockaddr *)&a, &len) ||
+        (fd[0] = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0)) < 0 ||
+        connect(fd[0], (struct sockaddr *)&a, sizeof(a)) ||
+        (fd[1] = accept4(l, NULL, NULL, SOCK_CLOEXEC)) < 0) {
+        close(l);
+        goto fail;
+    }
+    close(l);
+    setsockopt(fd[0], IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    setsockopt(fd[1], IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return TRUE;
+
+fail:
+    if (fd[0] >= 0) close(fd[0]);
+    if (fd[1] >= 0) close(fd[1]);
+    fd[0] = fd[1] = -1;
+    return FALSE;
+}
+
+/* MSG_ZEROCOPY completions; loopback reports them as copied */
+static void net_reap(net_data *nd, int fd)
+{
+#ifdef NET_ZEROCOPY
+    char control[128];
+    struct msghdr msg = { 0 };
+    struct cmsghdr *cm;
+
+    for (;;) {
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        if (recvmsg(fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+            return;
+        for (cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)) {
+            struct sock_extended_err *ee = (struct sock_extended_err *)CMSG_DATA(cm);
+            if (ee->ee_origin == SO_EE_ORIGIN_ZEROCOPY &&
+                (ee->ee_code & SO_EE_CODE_ZEROCOPY_COPIED))
+                g_atomic_int_set(&nd->copied, 1);
+        }
+    }
+#endif
+}
+
+static gssize net_send(net_data *nd, int fd, const gchar *buf, gsize block, int pipe_fd[2], guint64 sent)
+{
+    struct iovec iov;
+    gssize n, m, moved;
+    off_t off;
+
+    switch (nd->send) {
+#ifdef NET_ZEROCOPY
+    case NET_SEND_ZEROCOPY:
+        n = send(fd, buf, block, MSG_ZEROCOPY | MSG_NOSIGNAL);
+        if (n < 0 && errno == ENOBUFS) {
+            /* out of option memory until completions are read */
+            struct pollfd pfd = { fd, 0, 0 };
+            poll(&pfd, 1, 10);
+            n = 0;
+        }
+        net_reap(nd, fd);
+        return n;
+#endif
+    case NET_SEND_SENDFILE:
+        off = sent % NET_FILE;
+        return sendfile(fd, nd->file, &off, MIN(block, NET_FILE - off));
+    case NET_SEND_SPLICE:
+        iov.iov_base = (gchar *)buf;
+        iov.iov_len = MIN(block, NET_PIPE);
+        n = vmsplice(pipe_fd[1], &iov, 1, 0);
+        for (moved = 0; moved < n; moved += m) {
+            m = splice(pipe_fd[0], NULL, fd, NULL, n - moved, SPLICE_F_MOVE | SPLICE_F_MORE);
+            if (m <= 0) return -1;
+        }
+        return n;
+    default:
+        n = send(fd, buf, block, MSG_NOSIGNAL);
+        /* a full UDP queue drops, it does not block */
+        if (n < 0 && nd->type == SOCK_DGRAM && errno == ENOBUFS) n = 0;
+        return n;
+    }
+}
+
+static gpointer net_stream_thread(unsigned int start, unsigned int end, void *data, gint thread_number)
+{
+    net_data *nd = (net_data *)data;
+    gint s = thread_number / 2, i;
+    int fd = nd->fd[s][thread_number & 1], pipe_fd[2] = { -1, -1 };
+    gsize block = nd->type == SOCK_DGRAM ? NET_UDP_BLOCK : NET_BLOCK;
+    gchar *buf = g_malloc(NET_BLOCK);
+    gssize n;
+    gint64 t0;
+
+    if (thread_number & 1) {
+        while ((n = recv(fd, buf, NET_BLOCK, 0)) != 0) {
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                /* UDP has no end of stream, the timeout ends it */
+                if (nd->type != SOCK_DGRAM) g_atomic_int_inc(&nd->errors);
+                break;
+            }
+            nd->received[s] += n;
+            nd->end[s] = bench_time_nsec();
+        }
+        g_free(buf);
+        return NULL;
+    }
+
+    for (i = 0; i < NET_BLOCK; i++)
+        buf[i] = (gchar)(i * 7 + s);
+    if (nd->send == NET_SEND_SPLICE && pipe2(pipe_fd, O_CLOEXEC)) {
+        g_atomic_int_inc(&nd->errors);
+        goto done;
+    }
+
+    nd->start[s] = t0 = bench_time_nsec();
+    while (bench_time_nsec() - t0 < NET_STREAM_NSEC) {
+        n = net_send(nd, fd, buf, block, pipe_fd, nd->sent[s]);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            g_atomic_int_inc(&nd->errors);
+            break;
+        }
+        nd->sent[s] += n;
+    }
+
+done:
+    if (nd->type == SOCK_DGRAM) {
+        /* empty datagrams end the stream, if there is room for them */
+        for (i = 0; i < 8; i++)
+            send(fd, buf, 0, MSG_NOSIGNAL);
+    } else {
+        shutdown(fd, SHUT_WR);
+    }
+    if (pipe_fd[0] >= 0) {
+        close(pipe_fd[0]);
+        close(pipe_fd[1]);
+    }
+    g_free(buf);
+    return NULL;
+}
+
+/* aggregate Gbit/s, -1 if nothing could be sent */
+static double net_run(gint test, net_data *nd, gint streams)
+{
+    gint64 first = G_MAXINT64, last = 0;
+    guint64 bytes = 0;
+    double ret = -1;
+    int s;
+
+    memset(nd->fd, -1, sizeof(nd->fd));
+    memset(nd->start, 0, sizeof(nd->start));
+    memset(nd->end, 0, sizeof(nd->end));
+    memset(nd->sent, 0, sizeof(nd->sent));
+    memset(nd->received, 0, sizeof(nd->received));
+    nd->type = net_tests[test].type;
+    nd->send = net_tests[test].send;
+    nd->streams = net_tests[test].streams ? streams : 1;
+    nd->errors = 0;
+
+    for (s = 0; s < nd->streams; s++) {
+        if (!net_pair(net_tests[test].domain, nd->type, nd->fd[s]))
+            goto out;
+        net_timeout(nd->fd[s][0], SO_SNDTIMEO, NET_TIMEOUT_USEC);
+        if (nd->type == SOCK_DGRAM) {
+            int rcvbuf = 4 * 1024 * 1024;
+            setsockopt(nd->fd[s][1], SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+            net_timeout(nd->fd[s][1], SO_RCVTIMEO, NET_UDP_TIMEOUT_USEC);
+        } else {
+            net_timeout(nd->fd[s][1], SO_RCVTIMEO, NET_TIMEOUT_USEC);
+        }
+        if (nd->send == NET_SEND_ZEROCOPY) {
+#ifdef NET_ZEROCOPY
+            int one = 1;
+            if (setsockopt(nd->fd[s][0], SOL_SOCKET, SO_ZEROCOPY, &one, sizeof(one)))
+#endif
+                goto out;
+        }
+    }
+
+    benchmark_parallel(2 * nd->streams, net_stream_thread, nd);
+
+    for (s = 0; s < nd->streams; s++) {
+        if (!nd->received[s]) continue;
+        bytes += nd->received[s];
+        first = MIN(first, nd->start[s]);
+        last = MAX(last, nd->end[s]);
+    }
+    if (bytes && last > first && (!nd->errors || nd->type == SOCK_DGRAM))
+        ret = bytes * 8.0 / (last - first);
+
+out:
+    for (s = 0; s < NET_MAX_STREAMS; s++) {
+        if (nd->fd[s][0] >= 0) close(nd->fd[s][0]);
+        if (nd->fd[s][1] >= 0) close(nd->fd[s][1]);
+    }
+    return ret;
+}
+
+/* thread 0 times round trips, thread 1 echoes */
+static gpointer net_rtt_thread(unsigned int start, unsigned int end, void *data, gint thread_number)
+{
+    net_data *nd = (net_data *)data;
+    int fd = nd->fd[0][thread_number];
+    gchar buf[NET_MSG] = { 0 };
+    gssize n, got;
+    gint64 t0, t;
+    gint i;
+
+    if (thread_number == 1) {
+        /* a short datagram or the end of the stream stops it */
+        while ((n = recv(fd, buf, sizeof(buf), 0)) > 0) {
+            if (nd->type == SOCK_DGRAM && n < NET_MSG) break;
+            if (send(fd, buf, n, MSG_NOSIGNAL) != n) break;
+        }
+        return NULL;
+    }
+
+    t0 = bench_time_nsec();
+    for (i = 0; bench_time_nsec() - t0 < NET_RTT_NSEC; i++) {
+        t = bench_time_nsec();
+        if (send(fd, buf, NET_MSG, MSG_NOSIGNAL) != NET_MSG)
+            goto fail;
+        for (got = 0; got < NET_MSG; got += n) {
+            n = recv(fd, buf + got, NET_MSG - got, 0);
+            if (n <= 0) goto fail;
+        }
+        if (i >= NET_RTT_WARMUP) {
+            float usec = (bench_time_nsec() - t) / 1000.0;
+            g_array_append_val(nd->rtt, usec);
+        }
+    }
+    goto done;
+
+fail:
+    g_atomic_int_inc(&nd->errors);
+done:
+    if (nd->type == SOCK_DGRAM)
+        send(fd, buf, 1, MSG_NOSIGNAL);
+    else
+        shutdown(fd, SHUT_WR);
+    return NULL;
+}
+
+static int net_float_cmp(const void *a, const void *b)
+{
+    float A = *(const float *)a, B = *(const float *)b;
+    return (A > B) - (A < B);
+}
+
+/* p50, p99, p99.9 round trip of one kind of socket */
+static void net_rtt(gint test, net_data *nd, bench_value *r)
+{
+    static const double pct[3] = { 0.50, 0.99, 0.999 };
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS(pct); i++)
+        r->net_rtt[test][i] = -1;
+    nd->type = net_rtts[test].type;
+    nd->errors = 0;
+    if (!net_pair(net_rtts[test].domain, nd->type, nd->fd[0]))
+        return;
+    net_timeout(nd->fd[0][0], SO_RCVTIMEO, NET_TIMEOUT_USEC / 5);
+    net_timeout(nd->fd[0][1], SO_RCVTIMEO, NET_TIMEOUT_USEC / 5);
+
+    nd->rtt = g_array_new(FALSE, FALSE, sizeof(float));
+    benchmark_parallel(2, net_rtt_thread, nd);
+    close(nd->fd[0][0]);
+    close(nd->fd[0][1]);
+
+    if (nd->rtt->len && !nd->errors) {
+        qsort(nd->rtt->data, nd->rtt->len, sizeof(float), net_float_cmp);
+        for (i = 0; i < G_N_ELEMENTS(pct); i++)
+            r->net_rtt[test][i] = g_array_index(nd->rtt, float,
+                                                MIN((guint)(pct[i] * nd->rtt->len), nd->rtt->len - 1));
+    }
+    g_array_free(nd->rtt, TRUE);
+    nd->rtt = NULL;
+}
+
+/* sendfile() source, unlinked, in the page cache */
+static int net_file(void)
+{
+    gchar *path = NULL, *buf;
+    int fd, i;
+
+    fd = g_file_open_tmp("hardinfo2_net.XXXXXX", &path, NULL);
+    if (fd < 0) return -1;
+    unlink(path);
+    g_free(path);
+
+    buf = g_malloc(NET_FILE);
+    for (i = 0; i < NET_FILE; i++)
+        buf[i] = (gchar)(i * 7);
+    if (write(fd, buf, NET_FILE) != NET_FILE) {
+        close(fd);
+        fd = -1;
+    }
+    g_free(buf);
+    return fd;
+}
+
+void benchmark_network(void)
+{
+    bench_value r = EMPTY_BENCH_VALUE;
+    net_data nd = { 0 };
+    int cpu_cores, cpu_threads, t;
+    gchar *zerocopy = NULL;
+    GTimer *timer;
+
+    shell_view_set_enabled(FALSE);
+    shell_status_update("Measuring internal network speed...");
+
+    bench_workers_cores_threads(&cpu_cores, &cpu_threads);
+    r.net_streams = CLAMP(cpu_threads / 2, 2, NET_MAX_STREAMS);
+    r.net_tests = BENCH_NET_TESTS;
+    nd.file = -1;
+
+    timer = g_timer_new();
+    for (t = 0; t < BENCH_NET_TESTS; t++) {
+        r.net_gbits[t] = -1;
+        if (net_tests[t].send != NET_SEND_COPY && !params.bench_zerocopy)
+            continue;
+        if (net_tests[t].send == NET_SEND_SENDFILE && (nd.file = net_file()) < 0)
+            continue;
+        r.net_gbits[t] = net_run(t, &nd, r.net_streams);
+        if (t == BENCH_NET_UDP_STREAMS) {
+            guint64 sent = 0, received = 0;
+            int s;
+            for (s = 0; s < nd.streams; s++) {
+                sent += nd.sent[s];
+                received += nd.received[s];
+            }
+            r.net_udp_loss = sent ? 100.0 * (sent - MIN(received, sent)) / sent : 0;
+        }
+        if (nd.file >= 0) {
+            close(nd.file);
+            nd.file = -1;
+        }
+    }
+    for (t = 0; t < BENCH_NET_RTTS; t++)
+        net_rtt(t, &nd, &r);
+    r.elapsed_time = g_timer_elapsed(timer, NULL);
+    g_timer_destroy(timer);
+
+    r.result = r.net_gbits[BENCH_NET_TCP];
+    r.threads_used = 2;
+    if (params.bench_zerocopy)
+        zerocopy = g_strdup_printf(", zero-copy %.1f sendfile %.1f splice %.1f Gbit/s%s",
+                                   r.net_gbits[BENCH_NET_TCP_ZEROCOPY],
+                                   r.net_gbits[BENCH_NET_TCP_SENDFILE],
+                                   r.net_gbits[BENCH_NET_TCP_SPLICE],
+                                   nd.copied ? " (copied)" : "");
+    snprintf(r.extra, sizeof(r.extra),
+             "TCP %.1f, %dx TCP %.1f, UDP %.1f (%.1f%% loss), Unix %.1f Gbit/s, "
+             "RTT TCP %.1f UDP %.1f Unix %.1f us%s",
+             r.net_gbits[BENCH_NET_TCP], r.net_streams, r.net_gbits[BENCH_NET_TCP_STREAMS],
+             r.net_gbits[BENCH_NET_UDP_STREAMS], r.net_udp_loss,
+             r.net_gbits[BENCH_NET_UNIX_STREAMS], r.net_rtt[BENCH_NET_RTT_TCP][0],
+             r.net_rtt[BENCH_NET_RTT_UDP][0], r.net_rtt[BENCH_NET_RTT_UNIX][0],
+             zerocopy ? zerocopy : "");
+    g_free(zerocopy);
+
+    r.revision = BENCH_REVISION;
+    bench_results[BENCHMARK_NETWORK] = r;
+}
@@ -1,68 +1,246 @@
 /*
- * N-Queens Problem Solver
- * Found somewhere on the Internet; can't remember where. Possibly Wikipedia.
+ *    hardinfo2 - System Information and Benchmark
+ *    Copyright (C) 2026 hardinfo2 project
+ *    License: GPL2+
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License v2.0 or later.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
  */
-#include <stdio.h>
-#include <stdbool.h>
-#include <stdlib.h>
+
+/* N-Queens, all solutions for N = 14, 15 and 16, all threads.
+ *
+ * Bitmask backtracking: columns and both diagonals taken so far are three
+ * bit masks, the free squares of a row are what none of them cover. Only
+ * the left half of the first row is searched and counted twice (plus the
+ * middle column for odd N), by mirror symmetry.
+ *
+ * The tree is cut at a split depth: every valid placement of the first
+ * rows is a task, and the tasks run on the bench_steal_*() work stealing
+ * deques. Subtrees differ by orders of magnitude, so this is irregular,
+ * branchy parallel work. --bench-nqueens-depth sets the depth, by default
+ * the smallest one giving 64 tasks per thread. The sizes are solved in
+ * turn until CRUNCH_TIME has passed, counts are checked against the known
+ * ones. Result is thousand solutions per second.
+ *
+ * The work is fixed, so there is no throughput series and --bench-precision
+ * does not change it. A size is skipped when NQ_GROWTH times the last one
+ * would pass NQ_MAX_TIME (or --bench-budget), and a size still running at
+ * that point is stopped and not counted. --bench-sweep solves NQ_MIN on
+ * 1, 2, 4 ... threads. */
 
 #include "hardinfo.h"
 #include "benchmark.h"
 
 /* if anything changes in this block, increment revision */
-#define BENCH_REVISION 3
-#define QUEENS 9
+#define BENCH_REVISION 4
 #define CRUNCH_TIME 5
+#define NQ_MIN 14
+#define NQ_MAX 16
+#define NQ_MAX_TIME 60 /* stop here, slow machines */
+#define NQ_GROWTH 7    /* time of N+1 over N */
+#define NQ_TASKS_PER_THREAD 64
+
+static const guint64 nq_solutions[NQ_MAX + 1] = {
+    1, 1, 0, 0, 2, 10, 4, 40, 92, 352, 724, 2680, 14200, 73712, 365596,
+    2279184, 14772512,
+};
+
+typedef struct {
+    guint32 cols, ld, rd;
+    guint32 weight; /* 2 for a mirrored first row, else 1 */
+} nq_task;
+
+typedef struct {
+    guint32 all;
+    GArray *tasks;
+    bench_steal *steal;
+    gint64 deadline; /* bench_time_usec(), 0 for none */
+    gint stopped;
+} nq_job;
+
+static guint64 nq_solve(guint32 all, guint32 cols, guint32 ld, guint32 rd)
+{
+    guint32 free = all & ~(cols | ld | rd), bit;
+    guint64 n = 0;
+
+    if (cols == all)
+        return 1;
+    while (free) {
+        bit = free & -free;
+        free ^= bit;
+        n += nq_solve(all, cols | bit, (ld | bit) << 1, (rd | bit) >> 1);
+    }
+    return n;
+}
 
+static void nq_split(nq_job *job, gint depth, guint32 cols, guint32 ld, guint32 rd, guint32 weight)
+{
+    guint32 free = job->all & ~(cols | ld | rd), bit;
 
-bool safe(int x, int y,int *row) {
-    int i;
-    for (i = 1; i <= y; i++)
-        if (row[y - i] == x || row[y - i] == x - i || row[y - i] == x + i)
-            return false;
-    return true;
+    if (depth == 0 || cols == job->all) {
+        nq_task t = { cols, ld, rd, weight };
+        g_array_append_val(job->tasks, t);
+        return;
+    }
+    while (free) {
+        bit = free & -free;
+        free ^= bit;
+        nq_split(job, depth - 1, cols | bit, (ld | bit) << 1, (rd | bit) >> 1, weight);
+    }
 }
 
-int nqueens(int y,int *row) {
-    int x;
+/* first row by hand for the mirror, the rest by nq_split() */
+static void nq_tasks(nq_job *job, gint n, gint depth)
+{
+    guint32 bit;
+    gint col;
+
+    g_array_set_size(job->tasks, 0);
+    for (col = 0; col < (n + 1) / 2; col++) {
+        bit = 1u << col;
+        nq_split(job, depth - 1, bit, bit << 1, bit >> 1, (n % 2 && col == n / 2) ? 1 : 2);
+    }
+}
+
+static gpointer nq_thread(unsigned int start, unsigned int end, void *data, gint thread_number)
+{
+    nq_job *job = (nq_job *)data;
+    double *solutions = g_new0(double, 1);
+    guint64 n = 0;
+    guint i;
+
+    while (!g_atomic_int_get(&job->stopped) && bench_steal_next(job->steal, thread_number, &i)) {
+        nq_task *t = &g_array_index(job->tasks, nq_task, i);
+        n += t->weight * nq_solve(job->all, t->cols, t->ld, t->rd);
+        if (job->deadline && bench_time_usec() > job->deadline)
+            g_atomic_int_set(&job->stopped, 1);
+    }
+    *solutions = n;
+    return solutions;
+}
 
-    for (x = 0; x < QUEENS; x++) {
-      if (safe((row[y - 1] = x), y - 1, row)) {
-            if (y <= QUEENS) {
-	        nqueens(y + 1, row);
-            } else {
+/* all solutions of n on threads, depth is the split depth used; FALSE if
+ * stopped at the deadline */
+static gboolean nq_run(nq_job *job, gint n, gint threads, gint *depth, guint *steals, bench_value *v)
+{
+    gint d = params.bench_nqueens_depth;
+
+    job->all = (1u << n) - 1;
+    job->stopped = 0;
+    if (d > 0) {
+        d = MIN(d, n);
+        nq_tasks(job, n, d);
+    } else {
+        for (d = 1;; d++) {
+            nq_tasks(job, n, d);
+            if (job->tasks->len >= NQ_TASKS_PER_THREAD * (guint)threads || d >= n - 1)
                 break;
-            }
         }
     }
+    *depth = d;
 
-    return 0;
+    job->steal = bench_steal_new(threads, job->tasks->len);
+    *v = benchmark_parallel(threads, nq_thread, job);
+    *steals += bench_steal_count(job->steal);
+    bench_steal_free(job->steal);
+    return !job->stopped;
 }
 
-static gpointer nqueens_for(void *data, gint thread_number)
+/* --bench-sweep: NQ_MIN on 1, 2, 4 ... threads, thousand solutions/s */
+static void nq_sweep(nq_job *job, bench_value *r, gint cpu_threads, gint *errors)
 {
-    int row[QUEENS+1];
-    nqueens(1,row);
-
-    return NULL;
+    bench_value v;
+    guint steals = 0;
+    gint threads, depth;
+
+    job->deadline = 0;
+    for (threads = 1; r->sweep_steps < BENCH_MAX_SWEEP; threads = MIN(threads * 2, cpu_threads)) {
+        nq_run(job, NQ_MIN, threads, &depth, &steals, &v);
+        if ((guint64)v.result != nq_solutions[NQ_MIN])
+            (*errors)++;
+        r->sweep_threads[r->sweep_steps] = threads;
+        r->sweep_rate[r->sweep_steps++] = v.elapsed_time > 0 ? v.result / v.elapsed_time / 1000 : 0;
+        if (threads >= cpu_threads)
+            break;
+    }
+    benchmark_sweep_knee(r);
 }
 
-void
-benchmark_nqueens(void)
+void benchmark_nqueens(void)
 {
-    bench_value r = EMPTY_BENCH_VALUE;
+    bench_value r = EMPTY_BENCH_VALUE, v;
+    nq_job job = { 0 };
+    int cpu_cores, cpu_threads, n, depth = 0, used_depth = 0, errors = 0, largest = 0;
+    double solutions = 0, elapsed = 0, last = 0, limit = NQ_MAX_TIME;
+    guint tasks = 0, steals = 0;
+    gboolean stopped = FALSE;
+    gint64 start;
 
     shell_view_set_enabled(FALSE);
     shell_status_update("Running N-Queens benchmark...");
 
-    r = benchmark_crunch_for(CRUNCH_TIME, 0, nqueens_for, NULL);
+    bench_workers_cores_threads(&cpu_cores, &cpu_threads);
+    cpu_threads = MAX(cpu_threads, 1);
+    job.tasks = g_array_new(FALSE, FALSE, sizeof(nq_task));
+    if (benchmark_run_budget() > 0)
+        limit = MIN(limit, benchmark_run_budget());
 
-    r.revision = BENCH_REVISION;
-    snprintf(r.extra, 255, "q:%d", QUEENS-1);
+    start = bench_time_usec();
+    do {
+        for (n = NQ_MIN; n <= NQ_MAX; n++) {
+            if (n > NQ_MIN && elapsed + NQ_GROWTH * last > limit)
+                break;
+            /* the first size always completes, there is nothing else to report */
+            job.deadline = solutions > 0 ? start + (gint64)(limit * 1000000) : 0;
+            if (!nq_run(&job, n, cpu_threads, &depth, &steals, &v)) {
+                DEBUG("N=%d stopped after %.1f s", n, (bench_time_usec() - start) / 1e6);
+                stopped = TRUE;
+                break;
+            }
+
+            if ((guint64)v.result != nq_solutions[n])
+                errors++;
+            solutions += v.result;
+            elapsed += v.elapsed_time;
+            last = v.elapsed_time;
+            tasks = job.tasks->len;
+            used_depth = depth;
+            largest = MAX(largest, n);
+            /* counters of the last size solved */
+            r.counters = v.counters;
+            r.ipc = v.ipc;
+            r.mpki = v.mpki;
+            r.cache_miss_rate = v.cache_miss_rate;
+            r.branch_miss_rate = v.branch_miss_rate;
+            r.stalled_frontend = v.stalled_frontend;
+            r.stalled_backend = v.stalled_backend;
+        }
+    } while (!stopped && elapsed < CRUNCH_TIME && largest == NQ_MAX);
+
+    if (params.bench_sweep && cpu_threads > 1)
+        nq_sweep(&job, &r, cpu_threads, &errors);
+    g_array_free(job.tasks, TRUE);
+
+    r.threads_used = cpu_threads;
+    r.elapsed_time = elapsed;
+    if (errors) {
+        snprintf(r.extra, sizeof(r.extra), "wrong solution count, N=%d-%d", NQ_MIN, largest);
+    } else if (elapsed > 0) {
+        r.result = solutions / elapsed / 1000;
+        snprintf(r.extra, sizeof(r.extra),
+                 "N=%d-%d, %.0f solutions/s, depth %d, %u tasks, %u steals",
+                 NQ_MIN, largest, solutions / elapsed, used_depth, tasks, steals);
+    }
 
-    r.result /= 25;
-    
+    r.revision = BENCH_REVISION;
     bench_results[BENCHMARK_NQUEENS] = r;
 }
-
-
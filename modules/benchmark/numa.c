@@ -0,0 +1,180 @@
+/*
+ *    hardinfo2 - System Information and Benchmark
+ *    Copyright (C) 2026 hardinfo2 project
+ *    License: GPL2+
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License v2.0 or later.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/* NUMA node to node memory latency and bandwidth.
+ *
+ * For every memory node a buffer is bound to it with mbind() and threaded
+ * with a random pointer chain. Then, for every node with cpus, one worker
+ * pinned there follows the chain (latency) and all workers pinned there read
+ * the buffer (bandwidth). numa_latency[cpu node][memory node] in ns,
+ * numa_bandwidth[][] in GB/s. The result is the average bandwidth in MB/s.
+ * Without mbind() (no NUMA kernel, one node) the buffer is just local. */
+
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#include "hardinfo.h"
+#include "cpu_util.h"
+#include "benchmark.h"
+
+/* if anything changes in this block, increment revision */
+#define BENCH_REVISION 1
+#define NUMA_MIN_BUFFER (64L * 1024 * 1024)
+#define NUMA_READ_USEC 200000
+
+#ifndef MPOL_BIND
+#define MPOL_BIND 2
+#endif
+#ifndef MPOL_MF_MOVE
+#define MPOL_MF_MOVE (1 << 1)
+#endif
+
+typedef struct {
+    gchar *buf;
+    gsize size;
+    void **chain;
+    gint threads;
+} numa_data;
+
+static gboolean numa_bind(void *p, gsize size, gint node)
+{
+#ifdef SYS_mbind
+    unsigned long mask[4] = { 0 };
+    const int bits = 8 * sizeof(unsigned long);
+
+    if (node >= (int)G_N_ELEMENTS(mask) * bits) return FALSE;
+    mask[node / bits] = 1UL << (node % bits);
+    /* the kernel drops the last bit of maxnode */
+    return syscall(SYS_mbind, p, size, MPOL_BIND, mask,
+                   G_N_ELEMENTS(mask) * bits + 1, MPOL_MF_MOVE) == 0;
+#else
+    return FALSE;
+#endif
+}
+
+static gpointer numa_chase(unsigned int start, unsigned int end, void *data, gint thread_number)
+{
+    numa_data *nd = (numa_data *)data;
+    double *ns = g_new(double, 1);
+
+    *ns = bench_chase_ns(nd->chain);
+    return ns;
+}
+
+/* GB/s of this thread reading its slice of the buffer */
+static gpointer numa_read(unsigned int start, unsigned int end, void *data, gint thread_number)
+{
+    numa_data *nd = (numa_data *)data;
+    gsize n = nd->size / sizeof(guint64) / nd->threads, j, passes = 0;
+    const guint64 *p = (const guint64 *)nd->buf + n * thread_number;
+    guint64 s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    static volatile guint64 sink;
+    gint64 t0 = bench_time_usec(), usec;
+    double *gbs = g_new(double, 1);
+
+    n &= ~(gsize)3;
+    do {
+        for (j = 0; j < n; j += 4) {
+            s0 += p[j];
+            s1 += p[j + 1];
+            s2 += p[j + 2];
+            s3 += p[j + 3];
+        }
+        passes++;
+        usec = bench_time_usec() - t0;
+    } while (usec < NUMA_READ_USEC);
+
+    sink = s0 + s1 + s2 + s3;
+    *gbs = (double)n * sizeof(guint64) * passes / usec / 1000.0;
+    return gbs;
+}
+
+void benchmark_numa(void)
+{
+    bench_value r = EMPTY_BENCH_VALUE, v;
+    int cpu_procs, cpu_cores, cpu_threads, cpu_nodes, a, b, pairs = 0;
+    gint nodes[BENCH_MAX_NODES], n_nodes;
+    double lat_sum = 0, bw_sum = 0;
+    numa_data nd = { 0 };
+    gboolean bound = TRUE;
+    GTimer *timer;
+    gchar *tmp;
+
+    shell_view_set_enabled(FALSE);
+    shell_status_update("Measuring NUMA node latency and bandwidth...");
+
+    cpu_procs_cores_threads_nodes(&cpu_procs, &cpu_cores, &cpu_threads, &cpu_nodes);
+    /* node ids can be sparse, from the online mask */
+    n_nodes = bench_online_nodes(nodes, BENCH_MAX_NODES);
+    if (n_nodes < 1)
+        nodes[0] = 0;
+    r.numa_nodes = CLAMP(n_nodes, 1, BENCH_MAX_NUMA);
+    memcpy(r.numa_id, nodes, r.numa_nodes * sizeof(gint));
+
+    nd.size = MAX(NUMA_MIN_BUFFER, 4 * bench_llc_bytes());
+    tmp = module_call_method("computer::getMemoryTotal");
+    if (tmp) {
+        gsize memory = strtoul(tmp, NULL, 10) * 1024L;
+        g_free(tmp);
+        if (memory) nd.size = MIN(nd.size, memory / 16);
+    }
+
+    timer = g_timer_new();
+    for (a = 0; a < r.numa_nodes; a++) {
+        nd.buf = mmap(NULL, nd.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (nd.buf == MAP_FAILED) {
+            r.result = -1;
+            goto out;
+        }
+        if (r.numa_nodes > 1 && !numa_bind(nd.buf, nd.size, r.numa_id[a]))
+            bound = FALSE;
+        memset(nd.buf, 0, nd.size);
+        nd.chain = bench_chase_chain(nd.buf, nd.size);
+
+        for (b = 0; b < r.numa_nodes; b++) {
+            r.numa_latency[b][a] = r.numa_bandwidth[b][a] = -1;
+            if (!bench_workers_set_node(r.numa_nodes > 1 ? r.numa_id[b] : -1))
+                continue;
+            bench_workers_cores_threads(&cpu_cores, &nd.threads);
+
+            v = benchmark_parallel(1, numa_chase, &nd);
+            r.numa_latency[b][a] = v.result;
+            v = benchmark_parallel(nd.threads, numa_read, &nd);
+            r.numa_bandwidth[b][a] = v.result;
+
+            lat_sum += r.numa_latency[b][a];
+            bw_sum += r.numa_bandwidth[b][a];
+            pairs++;
+        }
+        munmap(nd.buf, nd.size);
+    }
+
+    r.elapsed_time = g_timer_elapsed(timer, NULL);
+    r.result = pairs ? 1000 * bw_sum / pairs : -1;
+    r.threads_used = cpu_threads;
+    snprintf(r.extra, sizeof(r.extra), "%d nodes, avg %.1f ns %.1f GB/s, %d MiB%s",
+             r.numa_nodes, pairs ? lat_sum / pairs : 0, pairs ? bw_sum / pairs : 0,
+             (int)(nd.size >> 20), bound ? "" : ", not bound");
+
+out:
+    bench_workers_set_node(-1);
+    g_timer_destroy(timer);
+    r.revision = BENCH_REVISION;
+    bench_results[BENCHMARK_NUMA] = r;
+}
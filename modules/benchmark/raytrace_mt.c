@@ -0,0 +1,306 @@
+/*
+ *    hardinfo2 - System Information and Benchmark
+ *    Copyright (C) 2026 hardinfo2 project
+ *    License: GPL2+
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License v2.0 or later.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/* Tiled Whitted ray tracer, all threads.
+ *
+ * A fixed scene (checkered floor, matte spheres on the left, a cluster of
+ * mirror spheres on the right, sky above) is rendered at 640x480 with 2x2
+ * samples per pixel in 16x16 tiles. Tile cost is very uneven: sky tiles
+ * cast one ray per sample, tiles in the mirror cluster up to a dozen.
+ *
+ * A frame is first rendered by a plain loop as the reference: checksum of
+ * every tile and rays per tile. Its RGB sums must be within RT_TOLERANCE
+ * of a known good render (rt_known_rgb), so a broken build of the tracer
+ * is caught; the sums are compared, not the checksums, as fused
+ * multiply-add and other rounding differences between compilers and cpus
+ * move an 8 bit value here and there. A run is then many frames, laid out
+ * tile by tile, so the first block of each worker's deque is one band of
+ * the image over all frames and the bands differ in cost; bench_steal_*()
+ * balances. Every tile rendered must match the reference checksum, which
+ * checks that the threads render the same image as the plain loop, not
+ * that the image is right. Rays per second
+ * are reported on one thread and on all threads; result is Mrays/s on all
+ * threads. The frame count is calibrated from the reference render. */
+
+#include <math.h>
+
+#include "hardinfo.h"
+#include "benchmark.h"
+
+/* if anything changes in this block, increment revision */
+#define BENCH_REVISION 1
+#define RT_WIDTH 640
+#define RT_HEIGHT 480
+#define RT_TILE 16
+#define RT_TILES_X (RT_WIDTH / RT_TILE)
+#define RT_TILES ((RT_WIDTH / RT_TILE) * (RT_HEIGHT / RT_TILE))
+#define RT_DEPTH 8
+#define RT_SECONDS 2.5
+#define RT_MAX_FRAMES 4096
+#define RT_TOLERANCE 0.001 /* of the RGB sums */
+
+/* R, G, B sums of the 8 bit pixels of the frame, x86-64 gcc -O2 */
+static const double rt_known_rgb[3] = { 33306403, 40149045, 50267418 };
+
+typedef struct { double x, y, z; } rt_vec;
+
+typedef struct {
+    rt_vec c;
+    double r;
+    rt_vec color;
+    double reflect;
+} rt_sphere;
+
+static inline rt_vec vec(double x, double y, double z) { rt_vec v = { x, y, z }; return v; }
+static inline rt_vec vadd(rt_vec a, rt_vec b) { return vec(a.x + b.x, a.y + b.y, a.z + b.z); }
+static inline rt_vec vsub(rt_vec a, rt_vec b) { return vec(a.x - b.x, a.y - b.y, a.z - b.z); }
+static inline rt_vec vmul(rt_vec a, double k) { return vec(a.x * k, a.y * k, a.z * k); }
+static inline double vdot(rt_vec a, rt_vec b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+static inline rt_vec vnorm(rt_vec a) { return vmul(a, 1.0 / sqrt(vdot(a, a))); }
+
+#define RT_SPHERES 17
+static rt_sphere rt_scene[RT_SPHERES];
+static const rt_vec rt_lights[2] = { { -6, 10, -4 }, { 5, 8, -6 } };
+static const rt_vec rt_eye = { 0, 2.2, -7 };
+
+/* matte spheres on the left, a tight 3x3 mirror cluster on the right */
+static void rt_scene_init(void)
+{
+    int i = 0, x, z;
+
+    rt_scene[i++] = (rt_sphere){ { -3.2, 1.0, 1.0 }, 1.0, { 0.9, 0.3, 0.2 }, 0 };
+    rt_scene[i++] = (rt_sphere){ { -1.6, 0.6, -0.8 }, 0.6, { 0.2, 0.8, 0.3 }, 0 };
+    rt_scene[i++] = (rt_sphere){ { -4.4, 0.5, -1.2 }, 0.5, { 0.3, 0.4, 0.9 }, 0 };
+    rt_scene[i++] = (rt_sphere){ { -2.4, 0.4, -2.0 }, 0.4, { 0.9, 0.9, 0.2 }, 0 };
+    rt_scene[i++] = (rt_sphere){ { -0.6, 1.4, 3.0 }, 1.4, { 0.7, 0.7, 0.7 }, 0.1 };
+    rt_scene[i++] = (rt_sphere){ { 0.4, 0.3, -2.6 }, 0.3, { 0.9, 0.5, 0.9 }, 0 };
+    rt_scene[i++] = (rt_sphere){ { 3.0, 3.6, 2.0 }, 0.9, { 0.9, 0.9, 0.9 }, 0.9 };
+    rt_scene[i++] = (rt_sphere){ { 1.2, 2.8, 1.4 }, 0.5, { 0.8, 0.8, 0.9 }, 0.8 };
+    for (x = 0; x < 3; x++)
+        for (z = 0; z < 3; z++)
+            rt_scene[i++] = (rt_sphere){ { 1.9 + 1.05 * x, 0.5, -1.0 + 1.05 * z }, 0.5,
+                                         { 0.9, 0.85, 0.8 }, 0.85 };
+}
+
+/* nearest sphere, or -1; -2 for the floor */
+static int rt_hit(rt_vec o, rt_vec d, double *t_out)
+{
+    double t_best = 1e30, b, c, disc, t;
+    int i, best = -1;
+
+    for (i = 0; i < RT_SPHERES; i++) {
+        rt_vec oc = vsub(o, rt_scene[i].c);
+        b = vdot(oc, d);
+        c = vdot(oc, oc) - rt_scene[i].r * rt_scene[i].r;
+        disc = b * b - c;
+        if (disc < 0) continue;
+        disc = sqrt(disc);
+        t = -b - disc;
+        if (t < 1e-6) t = -b + disc;
+        if (t > 1e-6 && t < t_best) {
+            t_best = t;
+            best = i;
+        }
+    }
+    if (d.y < -1e-9) {
+        t = -o.y / d.y;
+        if (t > 1e-6 && t < t_best && t < 60) {
+            t_best = t;
+            best = -2;
+        }
+    }
+    *t_out = t_best;
+    return best;
+}
+
+static rt_vec rt_trace(rt_vec o, rt_vec d, int depth, guint64 *rays)
+{
+    rt_vec p, n, color, col = { 0, 0, 0 };
+    double t, t_shadow, reflect, diffuse;
+    int hit, l;
+
+    (*rays)++;
+    hit = rt_hit(o, d, &t);
+    if (hit == -1)
+        return vec(0.4 + 0.3 * d.y, 0.6 + 0.3 * d.y, 0.95);
+
+    p = vadd(o, vmul(d, t));
+    if (hit == -2) {
+        n = vec(0, 1, 0);
+        color = ((int)floor(p.x) + (int)floor(p.z)) & 1 ? vec(0.9, 0.9, 0.9) : vec(0.15, 0.15, 0.2);
+        reflect = 0.2;
+    } else {
+        n = vnorm(vsub(p, rt_scene[hit].c));
+        color = rt_scene[hit].color;
+        reflect = rt_scene[hit].reflect;
+    }
+
+    col = vmul(color, 0.1);
+    for (l = 0; l < 2; l++) {
+        rt_vec to_light = vsub(rt_lights[l], p);
+        double dist = sqrt(vdot(to_light, to_light));
+        to_light = vmul(to_light, 1.0 / dist);
+        diffuse = vdot(n, to_light);
+        if (diffuse <= 0) continue;
+        (*rays)++;
+        if (rt_hit(p, to_light, &t_shadow) != -1 && t_shadow < dist) continue;
+        col = vadd(col, vmul(color, 0.45 * diffuse * (1 - reflect)));
+    }
+
+    if (reflect > 0 && depth < RT_DEPTH) {
+        rt_vec r = vsub(d, vmul(n, 2 * vdot(d, n)));
+        col = vadd(col, vmul(rt_trace(p, r, depth + 1, rays), reflect));
+    }
+    return col;
+}
+
+/* FNV-1a of the 8 bit RGB of the tile, their sums added to rgb if not NULL */
+static guint32 rt_tile(guint tile, guint64 *rays, double *rgb)
+{
+    int tx = tile % RT_TILES_X * RT_TILE, ty = tile / RT_TILES_X * RT_TILE;
+    guint32 sum = 2166136261u;
+    int x, y, s, k;
+
+    for (y = ty; y < ty + RT_TILE; y++)
+        for (x = tx; x < tx + RT_TILE; x++) {
+            rt_vec c = { 0, 0, 0 };
+            for (s = 0; s < 4; s++) {
+                double u = ((x + 0.25 + 0.5 * (s & 1)) / RT_WIDTH - 0.5) * 1.6;
+                double v = (0.5 - (y + 0.25 + 0.5 * (s >> 1)) / RT_HEIGHT) * 1.2;
+                rt_vec d = vnorm(vec(u, v - 0.18, 1.0));
+                c = vadd(c, rt_trace(rt_eye, d, 0, rays));
+            }
+            for (k = 0; k < 3; k++) {
+                double ch = (k == 0 ? c.x : k == 1 ? c.y : c.z) / 4;
+                guint8 byte = (guint8)(CLAMP(ch, 0, 1) * 255 + 0.5);
+                sum = (sum ^ byte) * 16777619u;
+                if (rgb) rgb[k] += byte;
+            }
+        }
+    return sum;
+}
+
+typedef struct {
+    bench_steal *steal;
+    guint frames;
+    const guint32 *ref;
+    gint errors;
+    gint64 t0;
+    gint64 *done;       /* per thread, usec since t0 when out of work */
+} rt_job;
+
+static gpointer rt_thread(unsigned int start, unsigned int end, void *data, gint thread_number)
+{
+    rt_job *job = (rt_job *)data;
+    guint64 rays = 0;
+    guint task;
+    gint errors = 0;
+
+    /* tile by tile: task / frames is the tile */
+    while (bench_steal_next(job->steal, thread_number, &task))
+        if (rt_tile(task / job->frames, &rays, NULL) != job->ref[task / job->frames])
+            errors++;
+    job->done[thread_number] = bench_time_usec() - job->t0;
+    if (errors)
+        g_atomic_int_add(&job->errors, errors);
+    return NULL;
+}
+
+/* Mrays/s, -1 if a tile did not match; idle is the percent of thread time
+ * spent waiting for the last tiles */
+static double rt_run(gint threads, guint frames, const guint32 *ref, guint64 frame_rays,
+                     guint *steals, double *idle)
+{
+    rt_job job = { .frames = frames, .ref = ref };
+    bench_value v;
+    gint64 busy = 0;
+    gint t;
+
+    job.steal = bench_steal_new(threads, frames * RT_TILES);
+    job.done = g_new0(gint64, threads);
+    job.t0 = bench_time_usec();
+    v = benchmark_parallel(threads, rt_thread, &job);
+    for (t = 0; t < threads; t++)
+        busy += job.done[t];
+    *steals = bench_steal_count(job.steal);
+    *idle = MAX(0, 100.0 * (1.0 - (double)busy / threads / MAX(v.elapsed_time * 1e6, 1)));
+    bench_steal_free(job.steal);
+    g_free(job.done);
+
+    if (job.errors || v.elapsed_time <= 0)
+        return -1;
+    return (double)frame_rays * frames / v.elapsed_time / 1e6;
+}
+
+void benchmark_raytrace_mt(void)
+{
+    bench_value r = EMPTY_BENCH_VALUE;
+    guint32 ref[RT_TILES], image = 0;
+    guint64 frame_rays = 0;
+    guint frames, steals, tile;
+    int cpu_cores, cpu_threads, k;
+    double rgb[3] = { 0 };
+    double single, all, idle, ref_time;
+    GTimer *timer;
+
+    shell_view_set_enabled(FALSE);
+    shell_status_update("Performing tiled ray tracing...");
+
+    bench_workers_cores_threads(&cpu_cores, &cpu_threads);
+    cpu_threads = MAX(cpu_threads, 1);
+    rt_scene_init();
+
+    /* the reference frame, plain loop */
+    timer = g_timer_new();
+    for (tile = 0; tile < RT_TILES; tile++) {
+        ref[tile] = rt_tile(tile, &frame_rays, rgb);
+        image = (image ^ ref[tile]) * 16777619u;
+    }
+    ref_time = MAX(g_timer_elapsed(timer, NULL), 1e-4);
+
+    for (k = 0; k < 3; k++)
+        if (fabs(rgb[k] - rt_known_rgb[k]) > RT_TOLERANCE * rt_known_rgb[k]) {
+            snprintf(r.extra, sizeof(r.extra),
+                     "image differs from the known render, RGB sums %.0f %.0f %.0f",
+                     rgb[0], rgb[1], rgb[2]);
+            g_timer_destroy(timer);
+            goto out;
+        }
+
+    frames = CLAMP((guint)(RT_SECONDS / ref_time), 1, MAX(RT_MAX_FRAMES / cpu_threads, 1));
+    single = rt_run(1, frames, ref, frame_rays, &steals, &idle);
+    all = rt_run(cpu_threads, frames * cpu_threads, ref, frame_rays, &steals, &idle);
+    r.elapsed_time = g_timer_elapsed(timer, NULL);
+    g_timer_destroy(timer);
+
+    r.threads_used = cpu_threads;
+    if (single < 0 || all < 0) {
+        snprintf(r.extra, sizeof(r.extra), "checksum mismatch, reference %08x", image);
+    } else {
+        r.result = all;
+        snprintf(r.extra, sizeof(r.extra),
+                 "1 thread %.2f, %d threads %.2f Mrays/s (%.1fx), %u steals, %.1f%% idle, "
+                 "%dx%d %d tiles, checksum %08x",
+                 single, cpu_threads, all, all / single, steals, idle,
+                 RT_WIDTH, RT_HEIGHT, RT_TILES, image);
+    }
+
+out:
+    r.revision = BENCH_REVISION;
+    bench_results[BENCHMARK_RAYTRACE_MT] = r;
+}
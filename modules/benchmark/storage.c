@@ -16,84 +16,515 @@
  *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
  */
 
+/* Storage read/write speed, in process.
+ *
+ * The target is --bench-storage, the home directory by default. A directory
+ * gets a test file, unlinked as soon as it is open; a block device or an
+ * existing file is only read. I/O is O_DIRECT where the filesystem allows it,
+ * so the page cache is not measured.
+ *
+ * With io_uring one thread keeps the queue depth in flight. Without it (old
+ * kernel or headers, io_uring disabled) the worker pool runs one worker per
+ * queue slot with pread()/pwrite(). Every I/O is timed for the latency
+ * percentiles; writes end with fdatasync(), inside the timing. Result is the
+ * average of the sequential 1 MiB read and write MB/s at queue depth 1, the
+ * same passes as the dd pipeline this replaces. */
+
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <sys/ioctl.h>
+#include <sys/statvfs.h>
+#include <sys/uio.h>
+#include <linux/fs.h>
+#ifdef HAS_IO_URING
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#endif
+
 #include "hardinfo.h"
 #include "benchmark.h"
-#include "math.h"
 
 /* if anything changes in this block, increment revision */
-#define BENCH_REVISION 2
+#define BENCH_REVISION 3
+#define STORAGE_SEQ_BLOCK (1024 * 1024)
+#define STORAGE_RAND_BLOCK 4096
+#define STORAGE_MIN_FILE (16L * 1024 * 1024)
+#define STORAGE_MAX_FILE (512L * 1024 * 1024)
+#define STORAGE_SEQ_NSEC 2000000000L
+#define STORAGE_RAND_NSEC 400000000L
+#define STORAGE_MAX_DEPTH 32
 
-static bench_value storage_runtest() {
-    bench_value ret = EMPTY_BENCH_VALUE;
-    gboolean spawned;
-    gchar *out=NULL, *err=NULL,*s=NULL;
-    int readbytes=0,writebytes=0,i=0;
-    float readspeed=0,writespeed=0;
-    float readtime=0,writetime=0;
-    char reade[5],writee[5];
-    int t=1;
-    const char *cmd_template = "sh -c ' \
-        export LC_ALL=C; \
-        cd ~ || exit 1; \
-        dd if=/dev/zero of=./hardinfo2_testfile bs=1M count=%d oflag=direct; \
-        dd of=/dev/zero if=./hardinfo2_testfile bs=1M iflag=direct; \
-        rm ./hardinfo2_testfile'";
-
-    gchar *cmd_line = g_strdup_printf(cmd_template, 20);
-    gchar *cmd_line_long = g_strdup_printf(cmd_template, 400);
-
-    gchar *saved_locale = g_strdup(setlocale(LC_NUMERIC, NULL));
-    setlocale(LC_NUMERIC,"C");
-    while(t){
-        if(t==1)
-	   spawned = g_spawn_command_line_sync(cmd_line, &out, &err, NULL, NULL);
-        else
-	   spawned = g_spawn_command_line_sync(cmd_line_long, &out, &err, NULL, NULL);
-        if (spawned && err){
-	    i=0;
-	    if( (s=strstr(err,"\n")) && (s=strstr(s+1,"\n")) ) {
-	        i=sscanf(s+1,"%d",&writebytes);
-	        if((i==1) && (s=strstr(s,")")) && (s=strstr(s+1,", ")) ){
-                     i=sscanf(s+2,"%f",&writetime);
-                     if((i==1) && (s=strstr(s+2,", ")))
-		         i=sscanf(s+2,"%f",&writespeed); else i=0;
-	        } else i=0;
+static const struct {
+    gboolean write, seq;
+    guint depth;
+} storage_tests[BENCH_STORAGE_TESTS] = {
+    [BENCH_STORAGE_SEQ_READ] = { FALSE, TRUE, 1 },
+    [BENCH_STORAGE_SEQ_WRITE] = { TRUE, TRUE, 1 },
+    [BENCH_STORAGE_READ_QD1] = { FALSE, FALSE, 1 },
+    [BENCH_STORAGE_READ_QD4] = { FALSE, FALSE, 4 },
+    [BENCH_STORAGE_READ_QD32] = { FALSE, FALSE, 32 },
+    [BENCH_STORAGE_WRITE_QD1] = { TRUE, FALSE, 1 },
+    [BENCH_STORAGE_WRITE_QD4] = { TRUE, FALSE, 4 },
+    [BENCH_STORAGE_WRITE_QD32] = { TRUE, FALSE, 32 },
+};
+
+/* the sequential write first, it fills the test file */
+static const gint storage_order[BENCH_STORAGE_TESTS] = {
+    BENCH_STORAGE_SEQ_WRITE, BENCH_STORAGE_SEQ_READ,
+    BENCH_STORAGE_READ_QD1, BENCH_STORAGE_READ_QD4, BENCH_STORAGE_READ_QD32,
+    BENCH_STORAGE_WRITE_QD1, BENCH_STORAGE_WRITE_QD4, BENCH_STORAGE_WRITE_QD32,
+};
+
+typedef struct {
+    GArray *lat;  /* float usec of each I/O */
+    guint64 rng;
+    gint errors;
+} storage_slot;
+
+typedef struct {
+    int fd;
+    gboolean write, seq;
+    guint depth;
+    gsize block;
+    guint64 size;     /* of the test range */
+    guint64 next;     /* sequential offset, tests of depth 1 only */
+    gint64 deadline;  /* bench_time_nsec() */
+    gchar *buf;       /* a block per slot */
+    storage_slot slots[STORAGE_MAX_DEPTH];
+} storage_job;
+
+static guint64 storage_rand(guint64 *x)
+{
+    /* xorshift64 */
+    *x ^= *x << 13;
+    *x ^= *x >> 7;
+    *x ^= *x << 17;
+    return *x;
+}
+
+static void storage_fill(guint64 *p, gsize n)
+{
+    guint64 x = 0x9e3779b97f4a7c15ULL;
+    gsize i;
+
+    for (i = 0; i < n; i++)
+        p[i] = storage_rand(&x);
+}
+
+static gboolean storage_next(storage_job *job, storage_slot *slot, guint64 *off)
+{
+    if (job->seq) {
+        if (job->next + job->block > job->size) return FALSE;
+        *off = job->next;
+        job->next += job->block;
+        return TRUE;
+    }
+    *off = (storage_rand(&slot->rng) % (job->size / job->block)) * job->block;
+    return TRUE;
+}
+
+static void storage_done(storage_slot *slot, gint64 nsec)
+{
+    float usec = nsec / 1000.0f;
+    g_array_append_val(slot->lat, usec);
+}
+
+/* pread()/pwrite() on one worker per queue slot */
+static gpointer storage_thread(unsigned int start, unsigned int end, void *data, gint thread_number)
+{
+    storage_job *job = (storage_job *)data;
+    storage_slot *slot = &job->slots[thread_number];
+    gchar *buf = job->buf + thread_number * job->block;
+    guint64 off;
+    gint64 t0;
+    ssize_t n;
+
+    while ((t0 = bench_time_nsec()) < job->deadline && storage_next(job, slot, &off)) {
+        n = job->write ? pwrite(job->fd, buf, job->block, off)
+                       : pread(job->fd, buf, job->block, off);
+        if (n != (ssize_t)job->block) {
+            slot->errors++;
+            break;
+        }
+        storage_done(slot, bench_time_nsec() - t0);
+    }
+    return NULL;
+}
+
+#ifdef HAS_IO_URING
+#ifndef IORING_FEAT_SINGLE_MMAP
+#define IORING_FEAT_SINGLE_MMAP (1U << 0)
+#endif
+
+typedef struct {
+    int fd;
+    unsigned *sq_tail, *sq_mask, *sq_array;
+    unsigned *cq_head, *cq_tail, *cq_mask;
+    struct io_uring_sqe *sqes;
+    struct io_uring_cqe *cqes;
+    void *sq_ring, *cq_ring;
+    gsize sq_size, cq_size, sqes_size;
+} storage_ring;
+
+static void storage_ring_free(storage_ring *ring)
+{
+    if (ring->sqes && ring->sqes != MAP_FAILED) munmap(ring->sqes, ring->sqes_size);
+    if (ring->cq_ring && ring->cq_ring != MAP_FAILED && ring->cq_ring != ring->sq_ring)
+        munmap(ring->cq_ring, ring->cq_size);
+    if (ring->sq_ring && ring->sq_ring != MAP_FAILED) munmap(ring->sq_ring, ring->sq_size);
+    if (ring->fd >= 0) close(ring->fd);
+    memset(ring, 0, sizeof(*ring));
+    ring->fd = -1;
+}
+
+/* raw syscalls, liburing is not needed for this little */
+static gboolean storage_ring_init(storage_ring *ring, guint depth)
+{
+    struct io_uring_params p;
+    gchar *sq, *cq;
+
+    memset(ring, 0, sizeof(*ring));
+    memset(&p, 0, sizeof(p));
+    ring->fd = syscall(__NR_io_uring_setup, depth, &p);
+    if (ring->fd < 0) {
+        DEBUG("io_uring not available: %s", g_strerror(errno));
+        return FALSE;
+    }
+
+    ring->sq_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    ring->cq_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP)
+        ring->sq_size = ring->cq_size = MAX(ring->sq_size, ring->cq_size);
+    ring->sq_ring = mmap(NULL, ring->sq_size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+    ring->cq_ring = (p.features & IORING_FEAT_SINGLE_MMAP) ? ring->sq_ring
+                  : mmap(NULL, ring->cq_size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+    ring->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+    if (ring->sq_ring == MAP_FAILED || ring->cq_ring == MAP_FAILED || ring->sqes == MAP_FAILED) {
+        storage_ring_free(ring);
+        return FALSE;
+    }
+
+    sq = ring->sq_ring;
+    cq = ring->cq_ring;
+    ring->sq_tail = (unsigned *)(sq + p.sq_off.tail);
+    ring->sq_mask = (unsigned *)(sq + p.sq_off.ring_mask);
+    ring->sq_array = (unsigned *)(sq + p.sq_off.array);
+    ring->cq_head = (unsigned *)(cq + p.cq_off.head);
+    ring->cq_tail = (unsigned *)(cq + p.cq_off.tail);
+    ring->cq_mask = (unsigned *)(cq + p.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+    return TRUE;
+}
+
+/* READV/WRITEV, they are in every kernel with io_uring */
+static void storage_ring_prep(storage_ring *ring, storage_job *job, guint slot,
+                              guint64 off, struct iovec *iov)
+{
+    unsigned tail = *ring->sq_tail, idx = tail & *ring->sq_mask;
+    struct io_uring_sqe *sqe = &ring->sqes[idx];
+
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = job->write ? IORING_OP_WRITEV : IORING_OP_READV;
+    sqe->fd = job->fd;
+    sqe->off = off;
+    sqe->addr = (guint64)(gsize)iov;
+    sqe->len = 1;
+    sqe->user_data = slot;
+    ring->sq_array[idx] = idx;
+    __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+}
+
+/* FALSE if the ring can not do this job, run it on the pool then */
+static gboolean storage_ring_run(storage_ring *ring, storage_job *job)
+{
+    struct iovec iov[STORAGE_MAX_DEPTH];
+    gint64 start[STORAGE_MAX_DEPTH], now;
+    storage_slot *slot = &job->slots[0];
+    guint i, inflight = 0, to_submit = 0;
+    unsigned head;
+    guint64 off;
+    int ret;
+
+    for (i = 0; i < job->depth && storage_next(job, slot, &off); i++) {
+        iov[i].iov_base = job->buf + i * job->block;
+        iov[i].iov_len = job->block;
+        start[i] = bench_time_nsec();
+        storage_ring_prep(ring, job, i, off, &iov[i]);
+        to_submit++;
+        inflight++;
+    }
+
+    while (inflight) {
+        ret = syscall(__NR_io_uring_enter, ring->fd, to_submit, 1,
+                      IORING_ENTER_GETEVENTS, NULL, 0);
+        if (ret < 0) {
+            if (errno == EINTR) continue;
+            DEBUG("io_uring_enter: %s", g_strerror(errno));
+            return FALSE;
+        }
+        to_submit -= MIN((guint)ret, to_submit);
+
+        head = *ring->cq_head;
+        while (head != __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE)) {
+            struct io_uring_cqe *cqe = &ring->cqes[head & *ring->cq_mask];
+            guint s = cqe->user_data;
+
+            now = bench_time_nsec();
+            head++;
+            inflight--;
+            if (cqe->res != (int)job->block) {
+                /* not supported at all: let the pool try */
+                if (slot->lat->len == 0 && (cqe->res == -EINVAL || cqe->res == -EOPNOTSUPP))
+                    return FALSE;
+                slot->errors++;
+                continue;
+            }
+            storage_done(slot, now - start[s]);
+            if (now < job->deadline && !slot->errors && storage_next(job, slot, &off)) {
+                start[s] = bench_time_nsec();
+                storage_ring_prep(ring, job, s, off, &iov[s]);
+                to_submit++;
+                inflight++;
             }
-	    if( (i==1) && (s=strstr(s+1,"\n")) && (s=strstr(s+1,"\n")) && (s=strstr(s+1,"\n")) ) {
-	        i=sscanf(s+1,"%d",&readbytes);
-	        if((i==1) && (s=strstr(s,")")) && (s=strstr(s+1,", ")) ){
-                     i=sscanf(s+2,"%f",&readtime);
-                     if((i==1) && (s=strstr(s+2,", ")))
-		          i=sscanf(s+2,"%f",&readspeed); else i=0;
-	        } else i=0;
+        }
+        __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+    }
+    return TRUE;
+}
+#endif
+
+static int storage_float_cmp(const void *a, const void *b)
+{
+    float A = *(const float *)a, B = *(const float *)b;
+    return (A > B) - (A < B);
+}
+
+/* IOPS, MB/s and percentiles of all slots into r */
+static void storage_result(bench_value *r, gint test, storage_job *job, gint64 nsec)
+{
+    static const double pct[3] = { 0.50, 0.99, 0.999 };
+    GArray *all = g_array_new(FALSE, FALSE, sizeof(float));
+    guint i;
+
+    for (i = 0; i < job->depth; i++)
+        g_array_append_vals(all, job->slots[i].lat->data, job->slots[i].lat->len);
+
+    if (all->len && nsec > 0) {
+        r->storage_iops[test] = all->len * 1e9 / nsec;
+        r->storage_mbs[test] = r->storage_iops[test] * job->block / (1024.0 * 1024.0);
+        qsort(all->data, all->len, sizeof(float), storage_float_cmp);
+        for (i = 0; i < G_N_ELEMENTS(pct); i++)
+            r->storage_lat[test][i] = g_array_index(all, float, MIN((guint)(pct[i] * all->len), all->len - 1));
+    }
+    g_array_free(all, TRUE);
+}
+
+static gchar *storage_speed_str(double mbs)
+{
+    if (mbs >= 1024) return g_strdup_printf("%0.2lf GB/s", mbs / 1024);
+    if (mbs >= 1) return g_strdup_printf("%0.2lf MB/s", mbs);
+    return g_strdup_printf("%0.2lf KB/s", mbs * 1024);
+}
+
+/* a test file in a directory, else read only on the device or file */
+static int storage_open(const gchar *path, gboolean *writable, gboolean *direct, guint64 *size)
+{
+    struct stat st;
+    struct statvfs vfs;
+    gchar *file;
+    int fd, flags;
+
+    *writable = *direct = FALSE;
+    *size = 0;
+    errno = 0;
+    if (stat(path, &st) != 0)
+        return -1;
+
+    if (S_ISDIR(st.st_mode)) {
+        if (statvfs(path, &vfs) == 0)
+            *size = MIN(STORAGE_MAX_FILE, (guint64)vfs.f_bavail * vfs.f_frsize / 4);
+        *size &= ~(guint64)(STORAGE_SEQ_BLOCK - 1);
+        if (*size < STORAGE_MIN_FILE) {
+            errno = ENOSPC;
+            return -1;
+        }
+        file = g_strdup_printf("%s/hardinfo2_testfile.%d", path, (int)getpid());
+        flags = O_RDWR | O_CREAT | O_EXCL;
+        fd = open(file, flags | O_DIRECT, 0600);
+        if (fd < 0 && errno == EINVAL) /* tmpfs and friends */
+            fd = open(file, flags, 0600);
+        else if (fd >= 0)
+            *direct = TRUE;
+        if (fd >= 0) {
+            unlink(file);
+            *writable = TRUE;
+        }
+        g_free(file);
+        return fd;
+    }
+
+    fd = open(path, O_RDONLY | O_DIRECT);
+    if (fd >= 0)
+        *direct = TRUE;
+    else
+        fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return -1;
+    if (S_ISBLK(st.st_mode)) {
+        if (ioctl(fd, BLKGETSIZE64, size) != 0) *size = 0;
+    } else {
+        *size = st.st_size;
+    }
+    *size &= ~(guint64)(STORAGE_SEQ_BLOCK - 1);
+    if (*size < STORAGE_SEQ_BLOCK) {
+        close(fd);
+        errno = EINVAL;
+        return -1;
+    }
+    return fd;
+}
+
+static bench_value storage_runtest(const gchar *path)
+{
+    bench_value ret = EMPTY_BENCH_VALUE;
+    storage_job job;
+    gboolean writable, direct, uring = FALSE;
+    guint64 size;
+    gint64 t0;
+    gchar *buf, *rd, *wr, *iops;
+    const gchar *note = "";
+    int fd, o, t;
+    guint i;
+#ifdef HAS_IO_URING
+    storage_ring ring;
+#endif
+
+    fd = storage_open(path, &writable, &direct, &size);
+    if (fd < 0) {
+        snprintf(ret.extra, sizeof(ret.extra), "cannot use target: %s", g_strerror(errno));
+        ret.revision = BENCH_REVISION;
+        return ret;
+    }
+
+    /* random bytes, so compressing drives do not get it for free */
+    /* one 1 MiB block, or STORAGE_MAX_DEPTH 4 KiB blocks */
+    buf = g_malloc(STORAGE_SEQ_BLOCK + 4096);
+    memset(&job, 0, sizeof(job));
+    job.buf = (gchar *)(((gsize)buf + 4095) & ~(gsize)4095);
+    storage_fill((guint64 *)job.buf, STORAGE_SEQ_BLOCK / sizeof(guint64));
+
+#ifdef HAS_IO_URING
+    uring = storage_ring_init(&ring, STORAGE_MAX_DEPTH);
+#endif
+
+    ret.storage_tests = BENCH_STORAGE_TESTS;
+    for (t = 0; t < BENCH_STORAGE_TESTS; t++) {
+        ret.storage_iops[t] = ret.storage_mbs[t] = -1;
+        ret.storage_lat[t][0] = ret.storage_lat[t][1] = ret.storage_lat[t][2] = -1;
+    }
+
+    ret.elapsed_time = 0;
+    for (o = 0; o < BENCH_STORAGE_TESTS; o++) {
+        t = storage_order[o];
+        if (storage_tests[t].write && !writable)
+            continue;
+
+        job.fd = fd;
+        job.write = storage_tests[t].write;
+        job.seq = storage_tests[t].seq;
+        job.depth = storage_tests[t].depth;
+        job.block = job.seq ? STORAGE_SEQ_BLOCK : STORAGE_RAND_BLOCK;
+        job.size = size;
+        job.next = 0;
+        for (i = 0; i < job.depth; i++) {
+            job.slots[i].lat = g_array_new(FALSE, FALSE, sizeof(float));
+            job.slots[i].rng = 0x2545f4914f6cdd1dULL * (i + 1) + t;
+            job.slots[i].errors = 0;
+        }
+
+        if (!job.write && !direct) {
+            /* best effort to read from the device, not the page cache */
+            fdatasync(fd);
+            posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        }
+
+        t0 = bench_time_nsec();
+        job.deadline = t0 + (job.seq ? STORAGE_SEQ_NSEC : STORAGE_RAND_NSEC);
+#ifdef HAS_IO_URING
+        if (uring && !storage_ring_run(&ring, &job)) {
+            storage_ring_free(&ring);
+            uring = FALSE;
+            for (i = 0; i < job.depth; i++) {
+                g_array_set_size(job.slots[i].lat, 0);
+                job.slots[i].errors = 0;
             }
-            if((i==1) && (readtime!=0) && (writetime!=0)){
-	        writespeed=writebytes/writetime;
-	        readspeed=readbytes/readtime;
-                ret.elapsed_time = writetime+readtime;
-		ret.result = (writespeed+readspeed)/2/(1024*1024);
-		strcpy(writee,"b/s");
-		strcpy(reade,"b/s");
-		if(writespeed>1024) {writespeed/=1024;strcpy(writee,"KB/s");}
-		if(writespeed>1024) {writespeed/=1024;strcpy(writee,"MB/s");}
-		if(writespeed>1024) {writespeed/=1024;strcpy(writee,"GB/s");}
-		if(readspeed>1024) {readspeed/=1024;strcpy(reade,"KB/s");}
-		if(readspeed>1024) {readspeed/=1024;strcpy(reade,"MB/s");}
-		if(readspeed>1024) {readspeed/=1024;strcpy(reade,"GB/s");}
-		snprintf(ret.extra, sizeof(ret.extra), "Read:%0.2lf %s, Write:%0.2lf %s %s",
-			readspeed,reade,writespeed,writee,(t==2?"(Long)":"") );
-	    }
-	}
-	g_free(out);
-	g_free(err);
-
-	if((t==1)&&(ret.elapsed_time<0.2)) t=2; else t=0; //second long run x20 - max 4 sec
+            job.next = 0;
+            t0 = bench_time_nsec();
+            job.deadline = t0 + (job.seq ? STORAGE_SEQ_NSEC : STORAGE_RAND_NSEC);
+        }
+#endif
+        if (!uring)
+            benchmark_parallel(job.depth, storage_thread, &job);
+        if (job.write)
+            fdatasync(fd);
+        storage_result(&ret, t, &job, bench_time_nsec() - t0);
+        ret.elapsed_time += (bench_time_nsec() - t0) / 1e9;
+
+        for (i = 0; i < job.depth; i++) {
+            if (job.slots[i].errors) note = ", I/O errors";
+            g_array_free(job.slots[i].lat, TRUE);
+        }
+
+        /* later tests stay within what the sequential write reached */
+        if (t == BENCH_STORAGE_SEQ_WRITE) {
+            if (job.next < STORAGE_SEQ_BLOCK) break;
+            size = job.next;
+        }
     }
 
-    setlocale(LC_NUMERIC,saved_locale);
-    g_free(saved_locale);
-    g_free(cmd_line);
-    g_free(cmd_line_long);
+#ifdef HAS_IO_URING
+    if (uring) storage_ring_free(&ring);
+#endif
+    close(fd);
+    g_free(buf);
+
+    if (writable)
+        ret.result = (ret.storage_mbs[BENCH_STORAGE_SEQ_READ] + ret.storage_mbs[BENCH_STORAGE_SEQ_WRITE]) / 2;
+    else
+        ret.result = ret.storage_mbs[BENCH_STORAGE_SEQ_READ];
+    if (ret.storage_mbs[BENCH_STORAGE_SEQ_READ] <= 0 || (writable && ret.storage_mbs[BENCH_STORAGE_SEQ_WRITE] <= 0))
+        ret.result = -1;
+
+    /* read/write */
+    rd = storage_speed_str(ret.storage_mbs[BENCH_STORAGE_SEQ_READ]);
+    if (writable) {
+        wr = storage_speed_str(ret.storage_mbs[BENCH_STORAGE_SEQ_WRITE]);
+        iops = g_strdup_printf("4K QD1 %.0f/%.0f IOPS, QD32 %.0f/%.0f IOPS",
+                               ret.storage_iops[BENCH_STORAGE_READ_QD1],
+                               ret.storage_iops[BENCH_STORAGE_WRITE_QD1],
+                               ret.storage_iops[BENCH_STORAGE_READ_QD32],
+                               ret.storage_iops[BENCH_STORAGE_WRITE_QD32]);
+    } else {
+        wr = g_strdup("-");
+        iops = g_strdup_printf("4K QD1 %.0f IOPS, QD32 %.0f IOPS",
+                               ret.storage_iops[BENCH_STORAGE_READ_QD1],
+                               ret.storage_iops[BENCH_STORAGE_READ_QD32]);
+    }
+    snprintf(ret.extra, sizeof(ret.extra), "Read:%s, Write:%s, %s, %d MiB, %s%s%s%s",
+             rd, wr, iops, (int)(size >> 20), uring ? "io_uring" : "threads",
+             direct ? "" : ", buffered", writable ? "" : ", read only", note);
+    g_free(rd);
+    g_free(wr);
+    g_free(iops);
 
     ret.threads_used = 1;
     ret.revision = BENCH_REVISION;
@@ -106,8 +537,7 @@ void benchmark_storage(void) {
     shell_view_set_enabled(FALSE);
     shell_status_update("Performing Storage Benchmark...");
 
-    r = storage_runtest();
+    r = storage_runtest(params.bench_storage ? params.bench_storage : g_get_home_dir());
 
     bench_results[BENCHMARK_STORAGE] = r;
 }
-
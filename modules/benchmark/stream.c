@@ -0,0 +1,286 @@
+/*
+ *    hardinfo2 - System Information and Benchmark
+ *    Copyright (C) 2026 hardinfo2 project
+ *    License: GPL2+
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License v2.0 or later.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/* STREAM style memory bandwidth on all threads.
+ *
+ * Every worker allocates and first touches its own part of the three arrays,
+ * so on NUMA machines the pages are local to the node it is pinned to. The
+ * workers run each kernel together between barriers; the aggregate rate is
+ * the bytes of all threads over the time from the first start to the last
+ * end, best of the repetitions after the first. Stores bypass the caches
+ * where the cpu has streaming stores, so there is no write-allocate traffic
+ * and the byte counts match. Result is Triad MB/s. */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "hardinfo.h"
+#include "cpu_util.h"
+#include "benchmark.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define STREAM_NT 1
+#endif
+
+/* if anything changes in this block, increment revision */
+#define BENCH_REVISION 1
+#define STREAM_TIMES 6
+#define STREAM_SCALAR 3.0
+#define STREAM_MIN_ARRAY (64L * 1024 * 1024)
+#define STREAM_MAX_NODES 16
+
+enum { STREAM_COPY, STREAM_SCALE, STREAM_ADD, STREAM_TRIAD, STREAM_KERNELS };
+static const char *stream_names[STREAM_KERNELS] = { "Copy", "Scale", "Add", "Triad" };
+static const int stream_arrays[STREAM_KERNELS] = { 2, 2, 3, 3 };
+
+typedef struct {
+    gint threads;
+    gsize n; /* elements of each array, per thread */
+    pthread_barrier_t barrier;
+    gint failed;
+    gint errors;
+    /* [thread][kernel][repetition] */
+    gint64 (*start)[STREAM_KERNELS][STREAM_TIMES];
+    gint64 (*end)[STREAM_KERNELS][STREAM_TIMES];
+} stream_data;
+
+static void stream_copy(double *c, const double *a, gsize n)
+{
+    gsize j;
+#ifdef STREAM_NT
+    for (j = 0; j < n; j += 2)
+        _mm_stream_pd(c + j, _mm_load_pd(a + j));
+    _mm_sfence();
+#else
+    for (j = 0; j < n; j++) c[j] = a[j];
+#endif
+}
+
+static void stream_scale(double *b, const double *c, double s, gsize n)
+{
+    gsize j;
+#ifdef STREAM_NT
+    __m128d vs = _mm_set1_pd(s);
+    for (j = 0; j < n; j += 2)
+        _mm_stream_pd(b + j, _mm_mul_pd(vs, _mm_load_pd(c + j)));
+    _mm_sfence();
+#else
+    for (j = 0; j < n; j++) b[j] = s * c[j];
+#endif
+}
+
+static void stream_add(double *c, const double *a, const double *b, gsize n)
+{
+    gsize j;
+#ifdef STREAM_NT
+    for (j = 0; j < n; j += 2)
+        _mm_stream_pd(c + j, _mm_add_pd(_mm_load_pd(a + j), _mm_load_pd(b + j)));
+    _mm_sfence();
+#else
+    for (j = 0; j < n; j++) c[j] = a[j] + b[j];
+#endif
+}
+
+static void stream_triad(double *a, const double *b, const double *c, double s, gsize n)
+{
+    gsize j;
+#ifdef STREAM_NT
+    __m128d vs = _mm_set1_pd(s);
+    for (j = 0; j < n; j += 2)
+        _mm_stream_pd(a + j, _mm_add_pd(_mm_load_pd(b + j), _mm_mul_pd(vs, _mm_load_pd(c + j))));
+    _mm_sfence();
+#else
+    for (j = 0; j < n; j++) a[j] = b[j] + s * c[j];
+#endif
+}
+
+/* same sequence on scalars */
+static gboolean stream_check(const double *a, const double *b, const double *c, gsize n)
+{
+    double aj = 1.0, bj = 2.0, cj = 0.0;
+    gsize j, at[] = { 0, n / 2, n - 1 };
+    int k;
+
+    for (k = 0; k < STREAM_TIMES; k++) {
+        cj = aj;
+        bj = STREAM_SCALAR * cj;
+        cj = aj + bj;
+        aj = bj + STREAM_SCALAR * cj;
+    }
+    for (k = 0; k < (int)G_N_ELEMENTS(at); k++) {
+        j = at[k];
+        if (fabs(a[j] - aj) > 1e-8 * aj || fabs(b[j] - bj) > 1e-8 * bj ||
+            fabs(c[j] - cj) > 1e-8 * cj)
+            return FALSE;
+    }
+    return TRUE;
+}
+
+static gpointer stream_thread(unsigned int start, unsigned int end, void *data, gint thread_number)
+{
+    stream_data *sd = (stream_data *)data;
+    gsize n = sd->n, j;
+    gchar *mem = g_try_malloc(3 * n * sizeof(double) + 64);
+    double *a = NULL, *b = NULL, *c = NULL;
+    int k, t;
+
+    if (mem) {
+        /* 64 byte aligned, n is a multiple of 8 so all three are */
+        a = (double *)(((gsize)mem + 63) & ~(gsize)63);
+        b = a + n;
+        c = b + n;
+        for (j = 0; j < n; j++) {
+            a[j] = 1.0;
+            b[j] = 2.0;
+            c[j] = 0.0;
+        }
+    } else {
+        g_atomic_int_set(&sd->failed, 1);
+    }
+
+    pthread_barrier_wait(&sd->barrier);
+    if (g_atomic_int_get(&sd->failed)) {
+        g_free(mem);
+        return NULL;
+    }
+
+    for (t = 0; t < STREAM_TIMES; t++) {
+        for (k = 0; k < STREAM_KERNELS; k++) {
+            pthread_barrier_wait(&sd->barrier);
+            sd->start[thread_number][k][t] = bench_time_usec();
+            switch (k) {
+            case STREAM_COPY: stream_copy(c, a, n); break;
+            case STREAM_SCALE: stream_scale(b, c, STREAM_SCALAR, n); break;
+            case STREAM_ADD: stream_add(c, a, b, n); break;
+            case STREAM_TRIAD: stream_triad(a, b, c, STREAM_SCALAR, n); break;
+            }
+            sd->end[thread_number][k][t] = bench_time_usec();
+        }
+    }
+
+    if (!stream_check(a, b, c, n))
+        g_atomic_int_inc(&sd->errors);
+
+    g_free(mem);
+    return NULL;
+}
+
+/* 4x the last level cache of all sockets, per array */
+static gsize stream_array_bytes(void)
+{
+    int cpu_procs, cpu_cores, cpu_threads, cpu_nodes;
+    gsize bytes;
+    gchar *tmp;
+
+    cpu_procs_cores_threads_nodes(&cpu_procs, &cpu_cores, &cpu_threads, &cpu_nodes);
+    bytes = MAX(STREAM_MIN_ARRAY, 4 * bench_llc_bytes() * cpu_procs);
+
+    tmp = module_call_method("computer::getMemoryTotal");
+    if (tmp) {
+        gsize memory = strtoul(tmp, NULL, 10) * 1024L;
+        g_free(tmp);
+        if (memory) bytes = MIN(bytes, memory / 16);
+    }
+    return bytes;
+}
+
+void benchmark_stream(void)
+{
+    bench_value r = EMPTY_BENCH_VALUE;
+    stream_data sd = { 0 };
+    int cpu_cores, cpu_threads, i, k, t, n_nodes = 0;
+    double rate[STREAM_KERNELS] = { 0 }, node_rate[STREAM_MAX_NODES] = { 0 };
+    gsize bytes;
+    gchar *nodes = NULL;
+
+    shell_view_set_enabled(FALSE);
+    shell_status_update("Running STREAM memory bandwidth benchmark...");
+
+    bench_workers_cores_threads(&cpu_cores, &cpu_threads);
+    bytes = stream_array_bytes();
+    sd.threads = MAX(cpu_threads, 1);
+    sd.n = MAX(bytes / sizeof(double) / sd.threads & ~(gsize)7, 8);
+    sd.start = g_malloc0(sd.threads * sizeof(*sd.start));
+    sd.end = g_malloc0(sd.threads * sizeof(*sd.end));
+    pthread_barrier_init(&sd.barrier, NULL, sd.threads);
+
+    r = benchmark_parallel(sd.threads, stream_thread, &sd);
+    pthread_barrier_destroy(&sd.barrier);
+
+    if (sd.failed || sd.errors || r.threads_used != sd.threads) {
+        r.result = -1;
+        snprintf(r.extra, sizeof(r.extra), "%s", sd.failed ? "out of memory" : "verification failed");
+        goto out;
+    }
+
+    /* aggregate: all threads from first start to last end; skip the first */
+    for (k = 0; k < STREAM_KERNELS; k++) {
+        double bytes_all = (double)stream_arrays[k] * sizeof(double) * sd.n * sd.threads;
+        for (t = 1; t < STREAM_TIMES; t++) {
+            gint64 first = G_MAXINT64, last = 0;
+            for (i = 0; i < sd.threads; i++) {
+                first = MIN(first, sd.start[i][k][t]);
+                last = MAX(last, sd.end[i][k][t]);
+            }
+            if (last > first)
+                rate[k] = MAX(rate[k], bytes_all / (last - first) / 1000.0);
+        }
+    }
+
+    /* per node: Triad of the threads pinned there, summed within each
+     * repetition (they ran together), best repetition */
+    for (t = 1; t < STREAM_TIMES; t++) {
+        double sum[STREAM_MAX_NODES] = { 0 }, bytes_one = 3.0 * sizeof(double) * sd.n;
+        for (i = 0; i < sd.threads; i++) {
+            gint node = bench_workers_node(i);
+            gint64 usec = sd.end[i][STREAM_TRIAD][t] - sd.start[i][STREAM_TRIAD][t];
+            if (node < 0 || node >= STREAM_MAX_NODES || usec <= 0) continue;
+            sum[node] += bytes_one / usec / 1000.0;
+        }
+        for (i = 0; i < STREAM_MAX_NODES; i++)
+            node_rate[i] = MAX(node_rate[i], sum[i]);
+    }
+    for (i = 0; i < STREAM_MAX_NODES; i++)
+        if (node_rate[i] > 0) {
+            nodes = appf(nodes, " ", "Node%d %.1f", i, node_rate[i]);
+            n_nodes++;
+        }
+
+    r.result = rate[STREAM_TRIAD] * 1000;
+    snprintf(r.extra, sizeof(r.extra), "%s %.1f %s %.1f %s %.1f %s %.1f GB/s, %d MiB/array%s%s%s",
+             stream_names[0], rate[0], stream_names[1], rate[1],
+             stream_names[2], rate[2], stream_names[3], rate[3],
+             (int)(sd.n * sd.threads * sizeof(double) >> 20),
+             n_nodes > 1 ? ", Triad " : "",
+             n_nodes > 1 ? nodes : "",
+#ifdef STREAM_NT
+             ", streaming stores"
+#else
+             ""
+#endif
+             );
+
+out:
+    r.revision = BENCH_REVISION;
+    bench_results[BENCHMARK_STREAM] = r;
+    g_free(nodes);
+    g_free(sd.start);
+    g_free(sd.end);
+}
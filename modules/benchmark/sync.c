@@ -0,0 +1,266 @@
+/*
+ *    hardinfo2 - System Information and Benchmark
+ *    Copyright (C) 2026 hardinfo2 project
+ *    License: GPL2+
+ *
+ *    This program is free software; you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License v2.0 or later.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/* Contended synchronization, 1 thread up to all.
+ *
+ * Every worker loops on one primitive for SYNC_USEC: atomic fetch-add on
+ * one shared counter and on a counter of its own cache line, a critical
+ * section under GMutex, pthread mutex, pthread rwlock (one write in 16)
+ * and a ticket spinlock. The critical section increments a shared counter,
+ * which must end up as the sum of all operations.
+ *
+ * Thread counts are 1, 2, 4 ... all, plus the last thread on the first
+ * socket and the first on the second: the pool fills one socket before
+ * the next, so those two steps show what crossing sockets costs. Recorded
+ * per step are Mops/s of all threads and fairness, min / max per thread
+ * ops/s (1 is fair). The sweep is the geometric mean of the primitives, and
+ * the result is that at all threads. */
+
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <math.h>
+
+#include "hardinfo.h"
+#include "cpu_util.h"
+#include "benchmark.h"
+
+/* if anything changes in this block, increment revision */
+#define BENCH_REVISION 1
+#define SYNC_USEC 100000
+#define SYNC_CHECK 64   /* ops between clock reads */
+#define SYNC_RW_WRITE 16
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SYNC_PAUSE() __builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define SYNC_PAUSE() __asm__ __volatile__("yield" ::: "memory")
+#else
+#define SYNC_PAUSE() do { } while (0)
+#endif
+
+#if GLIB_CHECK_VERSION(2,32,0)
+#define sync_gmutex GMutex
+#define sync_gmutex_init(m) g_mutex_init(m)
+#define sync_gmutex_lock(m) g_mutex_lock(m)
+#define sync_gmutex_unlock(m) g_mutex_unlock(m)
+#define sync_gmutex_clear(m) g_mutex_clear(m)
+#else
+#define sync_gmutex GStaticMutex
+#define sync_gmutex_init(m) g_static_mutex_init(m)
+#define sync_gmutex_lock(m) g_static_mutex_lock(m)
+#define sync_gmutex_unlock(m) g_static_mutex_unlock(m)
+#define sync_gmutex_clear(m) g_static_mutex_free(m)
+#endif
+
+typedef struct {
+    guint64 value;
+    gchar pad[120];
+} sync_line;
+
+typedef struct {
+    gint test;
+    sync_line shared;
+    sync_line ticket_next, ticket_serving;
+    sync_gmutex gmutex;
+    pthread_mutex_t mutex;
+    pthread_rwlock_t rwlock;
+    sync_line *own;      /* per thread */
+    guint64 *ops;        /* per thread */
+    guint64 *writes;     /* per thread, rwlock */
+    double *rate;        /* per thread ops/s */
+} sync_job;
+
+static gpointer sync_thread(unsigned int start, unsigned int end, void *data, gint thread_number)
+{
+    sync_job *job = (sync_job *)data;
+    gint64 t0 = bench_time_usec(), usec;
+    guint64 ops = 0, writes = 0, ticket, seen;
+
+    do {
+        gint i;
+        for (i = 0; i < SYNC_CHECK; i++, ops++) {
+            switch (job->test) {
+            case BENCH_SYNC_ATOMIC_SHARED:
+                __atomic_fetch_add(&job->shared.value, 1, __ATOMIC_SEQ_CST);
+                break;
+            case BENCH_SYNC_ATOMIC_PADDED:
+                __atomic_fetch_add(&job->own[thread_number].value, 1, __ATOMIC_SEQ_CST);
+                break;
+            case BENCH_SYNC_GMUTEX:
+                sync_gmutex_lock(&job->gmutex);
+                job->shared.value++;
+                sync_gmutex_unlock(&job->gmutex);
+                break;
+            case BENCH_SYNC_MUTEX:
+                pthread_mutex_lock(&job->mutex);
+                job->shared.value++;
+                pthread_mutex_unlock(&job->mutex);
+                break;
+            case BENCH_SYNC_RWLOCK:
+                if (ops % SYNC_RW_WRITE == 0) {
+                    pthread_rwlock_wrlock(&job->rwlock);
+                    job->shared.value++;
+                    pthread_rwlock_unlock(&job->rwlock);
+                    writes++;
+                } else {
+                    pthread_rwlock_rdlock(&job->rwlock);
+                    seen = *(volatile guint64 *)&job->shared.value;
+                    pthread_rwlock_unlock(&job->rwlock);
+                    (void)seen;
+                }
+                break;
+            case BENCH_SYNC_TICKET:
+                ticket = __atomic_fetch_add(&job->ticket_next.value, 1, __ATOMIC_RELAXED);
+                while (__atomic_load_n(&job->ticket_serving.value, __ATOMIC_ACQUIRE) != ticket)
+                    SYNC_PAUSE();
+                job->shared.value++;
+                __atomic_store_n(&job->ticket_serving.value, ticket + 1, __ATOMIC_RELEASE);
+                break;
+            }
+        }
+        usec = bench_time_usec() - t0;
+    } while (usec < SYNC_USEC);
+
+    job->ops[thread_number] = ops;
+    job->writes[thread_number] = writes;
+    job->rate[thread_number] = ops * 1e6 / MAX(usec, 1);
+    return NULL;
+}
+
+/* Mops/s of all threads and min/max fairness, FALSE if the count is off */
+static gboolean sync_run(gint test, gint threads, float *mops, float *fair)
+{
+    sync_job job = { .test = test };
+    guint64 expect = 0;
+    double sum = 0, lo = 0, hi = 0;
+    gboolean ok;
+    gint t;
+
+    sync_gmutex_init(&job.gmutex);
+    pthread_mutex_init(&job.mutex, NULL);
+    pthread_rwlock_init(&job.rwlock, NULL);
+    job.own = g_new0(sync_line, threads);
+    job.ops = g_new0(guint64, threads);
+    job.writes = g_new0(guint64, threads);
+    job.rate = g_new0(double, threads);
+
+    benchmark_parallel(threads, sync_thread, &job);
+
+    for (t = 0; t < threads; t++) {
+        sum += job.rate[t];
+        lo = t ? MIN(lo, job.rate[t]) : job.rate[t];
+        hi = MAX(hi, job.rate[t]);
+        if (test == BENCH_SYNC_RWLOCK)
+            expect += job.writes[t];
+        else if (test == BENCH_SYNC_ATOMIC_PADDED)
+            expect += (job.own[t].value == job.ops[t]) ? 0 : 1;
+        else
+            expect += job.ops[t];
+    }
+    ok = (test == BENCH_SYNC_ATOMIC_PADDED) ? expect == 0 : expect == job.shared.value;
+    *mops = sum / 1e6;
+    *fair = hi > 0 ? lo / hi : 0;
+
+    sync_gmutex_clear(&job.gmutex);
+    pthread_mutex_destroy(&job.mutex);
+    pthread_rwlock_destroy(&job.rwlock);
+    g_free(job.own);
+    g_free(job.ops);
+    g_free(job.writes);
+    g_free(job.rate);
+    return ok;
+}
+
+static gint sync_int_cmp(gconstpointer a, gconstpointer b)
+{
+    return *(const gint *)a - *(const gint *)b;
+}
+
+/* 1, 2, 4 ... threads and the socket boundary, sorted, unique */
+static gint sync_steps(gint *steps, gint threads)
+{
+    int procs, cores, cpu_threads, nodes;
+    gint n = 0, i, t, per_socket;
+
+    for (t = 1; t < threads && n < BENCH_MAX_SWEEP - 3; t *= 2)
+        steps[n++] = t;
+    steps[n++] = threads;
+
+    cpu_procs_cores_threads_nodes(&procs, &cores, &cpu_threads, &nodes);
+    if (procs > 1 && cores > procs) {
+        per_socket = cores / procs;
+        if (per_socket < threads) steps[n++] = per_socket;
+        if (per_socket + 1 < threads) steps[n++] = per_socket + 1;
+    }
+
+    qsort(steps, n, sizeof(gint), sync_int_cmp);
+    for (i = 1, t = 1; i < n; i++)
+        if (steps[i] != steps[t - 1])
+            steps[t++] = steps[i];
+    return t;
+}
+
+void benchmark_sync(void)
+{
+    bench_value r = EMPTY_BENCH_VALUE;
+    int cpu_cores, cpu_threads, step, test, errors = 0;
+    gint steps[BENCH_MAX_SWEEP];
+    GTimer *timer;
+
+    shell_view_set_enabled(FALSE);
+    shell_status_update("Running synchronization benchmark...");
+
+    bench_workers_cores_threads(&cpu_cores, &cpu_threads);
+    cpu_threads = MAX(cpu_threads, 1);
+
+    timer = g_timer_new();
+    r.sweep_steps = sync_steps(steps, cpu_threads);
+    for (step = 0; step < r.sweep_steps; step++) {
+        double log_sum = 0;
+        r.sweep_threads[step] = steps[step];
+        for (test = 0; test < BENCH_SYNC_TESTS; test++) {
+            if (!sync_run(test, steps[step], &r.sync_mops[test][step], &r.sync_fair[test][step]))
+                errors++;
+            log_sum += log(MAX(r.sync_mops[test][step], 1e-6));
+        }
+        r.sweep_rate[step] = exp(log_sum / BENCH_SYNC_TESTS);
+    }
+    r.elapsed_time = g_timer_elapsed(timer, NULL);
+    g_timer_destroy(timer);
+    r.sync_tests = BENCH_SYNC_TESTS;
+    benchmark_sweep_knee(&r);
+
+    step = r.sweep_steps - 1;
+    r.threads_used = cpu_threads;
+    if (errors) {
+        snprintf(r.extra, sizeof(r.extra), "%d runs with a wrong count", errors);
+    } else {
+        r.result = r.sweep_rate[step];
+        snprintf(r.extra, sizeof(r.extra),
+                 "%d threads Mops/s: atomic %.1f, padded %.1f, GMutex %.1f, mutex %.1f, "
+                 "rwlock %.1f, ticket %.1f; fairness mutex %.2f ticket %.2f",
+                 cpu_threads,
+                 r.sync_mops[BENCH_SYNC_ATOMIC_SHARED][step], r.sync_mops[BENCH_SYNC_ATOMIC_PADDED][step],
+                 r.sync_mops[BENCH_SYNC_GMUTEX][step], r.sync_mops[BENCH_SYNC_MUTEX][step],
+                 r.sync_mops[BENCH_SYNC_RWLOCK][step], r.sync_mops[BENCH_SYNC_TICKET][step],
+                 r.sync_fair[BENCH_SYNC_MUTEX][step], r.sync_fair[BENCH_SYNC_TICKET][step]);
+    }
+
+    r.revision = BENCH_REVISION;
+    bench_results[BENCHMARK_SYNC] = r;
+}
@@ -87,7 +87,6 @@ Recommends:     glx-utils
 Recommends:     dmidecode
 Recommends:     udisks2
 Recommends:     xdg-utils
-Recommends:     iperf3
 %endif
 
 %description